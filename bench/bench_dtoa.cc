@@ -30,6 +30,11 @@
 
 #define BENCH_TO_DECIMAL()      0
 
+#define BENCH_HALF()            0
+#define BENCH_LONG_DOUBLE()     0
+#define BENCH_INTEGER()         0
+#define BENCH_ROUND10()         0
+
 //==================================================================================================
 //
 //==================================================================================================
@@ -87,6 +92,7 @@ struct D2S
 struct D2S
 {
     static char const* Name() { return "grisu2"; }
+    char* operator()(char* buf, int /*buflen*/, float f) const { return grisu2::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) const { return grisu2::Dtoa(buf, f); }
 };
 #endif
@@ -105,6 +111,7 @@ struct D2S
 struct D2S
 {
     static char const* Name() { return "grisu3"; }
+    char* operator()(char* buf, int /*buflen*/, float f) const { return grisu3::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) const { return grisu3::Dtoa(buf, f); }
 };
 #endif
@@ -114,10 +121,19 @@ struct D2S
 struct D2S
 {
     static char const* Name() { return "dragonbox"; }
+    char* operator()(char* buf, int /*buflen*/, float f) const { return dragonbox::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) const { return dragonbox::Dtoa(buf, f); }
 };
 #endif
 
+#if BENCH_HALF()
+#include "schubfach_16.h"
+#endif
+
+#if BENCH_LONG_DOUBLE()
+#include "schubfach_128.h"
+#endif
+
 //==================================================================================================
 //
 //==================================================================================================
@@ -174,7 +190,7 @@ public:
     uint32_t operator()() { return Gen(); }
 };
 
-static JenkinsRandom random;
+static JenkinsRandom rng;
 
 //==================================================================================================
 //
@@ -259,7 +275,7 @@ static inline void Register_RandomBits_double()
     std::vector<double> numbers(NumFloats);
 
     std::uniform_int_distribution<uint64_t> gen(1, 0x7FF0000000000000ull - 1);
-    std::generate(numbers.begin(), numbers.end(), [&] { return ReinterpretBits<double>(gen(random)); });
+    std::generate(numbers.begin(), numbers.end(), [&] { return ReinterpretBits<double>(gen(rng)); });
 
     RegisterBenchmarks("Random-bits", numbers);
 }
@@ -269,7 +285,7 @@ static inline void Register_RandomBits_single()
     std::vector<float> numbers(NumFloats);
 
     std::uniform_int_distribution<uint32_t> gen(1, 0x7F800000u - 1);
-    std::generate(numbers.begin(), numbers.end(), [&] { return ReinterpretBits<float>(gen(random)); });
+    std::generate(numbers.begin(), numbers.end(), [&] { return ReinterpretBits<float>(gen(rng)); });
 
     RegisterBenchmarks("Random-bits", numbers);
 }
@@ -283,7 +299,7 @@ static inline void Register_Uniform(Float low, Float high)
     std::vector<Float> numbers(NumFloats);
 
     std::uniform_real_distribution<Float> gen(low, high);
-    std::generate(numbers.begin(), numbers.end(), [&] { return gen(random); });
+    std::generate(numbers.begin(), numbers.end(), [&] { return gen(rng); });
 
     RegisterBenchmarks(StrPrintf("Uniform %.1g/%.1g", low, high), numbers);
 }
@@ -325,7 +341,7 @@ static inline void Register_Digits_double(const char* name, int digits, int e10)
     std::uniform_int_distribution<int64_t> gen(kPow10_i64[digits - 1], kPow10_i64[digits] - 1);
 
     std::generate(numbers.begin(), numbers.end(), [&] {
-        int64_t n = gen(random);
+        int64_t n = gen(rng);
         if (n % 10 == 0)
             n += 1;
         std::string s;
@@ -369,7 +385,7 @@ static inline void Register_Digits_single(const char* name, int digits, int e10)
     std::uniform_int_distribution<int32_t> gen(kPow10_i32[digits - 1], kPow10_i32[digits] - 1);
 
     std::generate(numbers.begin(), numbers.end(), [&] {
-        int32_t n = gen(random);
+        int32_t n = gen(rng);
         if (n % 10 == 0)
             n += 1;
         std::string s;
@@ -401,7 +417,7 @@ static inline std::vector<double> GenRandomDigitData_double(int num_digits, int
 
     for (int i = 0; i < count; ++i)
     {
-        const double d = gen(random);
+        const double d = gen(rng);
         const double rounded = ryu::Round10(d, -num_digits);
         result[i] = rounded;
     }
@@ -427,7 +443,7 @@ static inline std::vector<float> GenRandomDigitData_float(int digits, int count)
 
     for (int i = 0; i < count; ++i)
     {
-        const float d = gen(random);
+        const float d = gen(rng);
         const float rounded = ryu::Round10(d, -digits);
         result[i] = rounded;
     }
@@ -440,6 +456,411 @@ static inline void Register_RandomDigits_float(const char* name, int digits)
     RegisterBenchmarks(name, GenRandomDigitData_float(digits, NumFloats));
 }
 
+//--------------------------------------------------------------------------------------------------
+// Half-precision: schubfach::Htoa vs. schubfach::HtoaTable
+//--------------------------------------------------------------------------------------------------
+
+#if BENCH_HALF()
+struct H2SSchubfach
+{
+    char* operator()(char* buf, uint16_t value) const { return schubfach::Htoa(buf, value); }
+};
+
+#if SCHUBFACH_HALF_TABLE
+struct H2STable
+{
+    char* operator()(char* buf, uint16_t value) const { return schubfach::HtoaTable(buf, value); }
+};
+#endif
+
+// Converts all the given numbers in each iteration.
+// If cold is true, the caches are flushed before each iteration (which is not timed).
+template <typename H2S>
+static inline void BenchHalf(benchmark::State& state, std::vector<uint16_t> const& numbers, bool cold)
+{
+    H2S h2s;
+
+    std::vector<char> flush(cold ? 32 * 1024 * 1024 : 0);
+
+    uint64_t sum = 0;
+    for (auto _ : state)
+    {
+        if (cold)
+        {
+            state.PauseTiming();
+            for (size_t i = 0; i < flush.size(); i += 64)
+                flush[i]++;
+            benchmark::ClobberMemory();
+            state.ResumeTiming();
+        }
+
+        for (const uint16_t value : numbers)
+        {
+            char buffer[BufSize];
+            h2s(buffer, value);
+            sum += static_cast<unsigned char>(buffer[0]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+
+    if (sum == UINT64_MAX)
+        abort();
+}
+
+static inline void Register_Half(const char* name, int count, bool cold)
+{
+    std::vector<uint16_t> numbers(static_cast<size_t>(count));
+
+    std::uniform_int_distribution<uint32_t> gen(0, 0xFFFF);
+    std::generate(numbers.begin(), numbers.end(), [&] { return static_cast<uint16_t>(gen(rng)); });
+
+    // Flushing the caches is much more expensive than the conversions, so use a fixed number of
+    // iterations for the cold benchmarks.
+    const int64_t iterations = cold ? 500 : 0;
+
+    auto* b1 = benchmark::RegisterBenchmark(StrPrintf("half - %s - Htoa      ", name), BenchHalf<H2SSchubfach>, numbers, cold);
+    if (iterations > 0)
+        b1->Iterations(iterations);
+#if SCHUBFACH_HALF_TABLE
+    auto* b2 = benchmark::RegisterBenchmark(StrPrintf("half - %s - HtoaTable ", name), BenchHalf<H2STable>, numbers, cold);
+    if (iterations > 0)
+        b2->Iterations(iterations);
+#endif
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// x87 extended precision: schubfach::LDtoa vs. printf("%Lg")
+//--------------------------------------------------------------------------------------------------
+
+#if BENCH_LONG_DOUBLE()
+#if SCHUBFACH_LONG_DOUBLE80
+struct LD2SSchubfach
+{
+    char* operator()(char* buf, long double value) const { return schubfach::LDtoa(buf, value); }
+};
+
+// "%.21Lg" round-trips, but is not shortest.
+struct LD2SPrintf
+{
+    char* operator()(char* buf, long double value) const { return buf + std::snprintf(buf, BufSize, "%.21Lg", value); }
+};
+
+struct LD2SPrintfDefault
+{
+    char* operator()(char* buf, long double value) const { return buf + std::snprintf(buf, BufSize, "%Lg", value); }
+};
+
+template <typename LD2S>
+static inline void BenchLongDouble(benchmark::State& state, std::vector<long double> const& numbers)
+{
+    LD2S ld2s;
+
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        for (const long double value : numbers)
+        {
+            char buffer[BufSize];
+            char* end = ld2s(buffer, value);
+            sum += static_cast<size_t>(end - buffer);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+
+    if (sum == 0)
+        abort();
+}
+
+static inline void Register_LongDouble(const char* name, std::vector<long double> const& numbers)
+{
+    benchmark::RegisterBenchmark(StrPrintf("long double - %s - LDtoa   ", name), BenchLongDouble<LD2SSchubfach>, numbers);
+    benchmark::RegisterBenchmark(StrPrintf("long double - %s - %%.21Lg ", name), BenchLongDouble<LD2SPrintf>, numbers);
+    benchmark::RegisterBenchmark(StrPrintf("long double - %s - %%Lg    ", name), BenchLongDouble<LD2SPrintfDefault>, numbers);
+}
+
+static inline void Register_LongDouble_RandomBits()
+{
+    std::vector<long double> numbers(static_cast<size_t>(NumFloats));
+
+    std::uniform_int_distribution<uint64_t> gen(0, UINT64_MAX);
+    std::generate(numbers.begin(), numbers.end(), [&] {
+        // Random sign and exponent (excluding inf/nan), random significand. The integer bit is set
+        // iff the number is normal.
+        const uint16_t exponent = static_cast<uint16_t>(gen(rng) % 0x7FFF);
+        const uint16_t sign_exponent = static_cast<uint16_t>(exponent | (gen(rng) & 0x8000));
+        const uint64_t integer_bit = uint64_t{1} << 63;
+        const uint64_t significand = exponent != 0 ? (gen(rng) | integer_bit) : (gen(rng) & ~integer_bit);
+
+        unsigned char raw[sizeof(long double)] = {};
+        std::memcpy(raw, &significand, 8);
+        std::memcpy(raw + 8, &sign_exponent, 2);
+        long double value;
+        std::memcpy(&value, raw, sizeof(long double));
+        return value;
+    });
+
+    Register_LongDouble("random bits", numbers);
+}
+
+static inline void Register_LongDouble_Uniform(long double low, long double high)
+{
+    std::vector<long double> numbers(static_cast<size_t>(NumFloats));
+
+    std::uniform_real_distribution<long double> gen(low, high);
+    std::generate(numbers.begin(), numbers.end(), [&] { return gen(rng); });
+
+    Register_LongDouble(StrPrintf("uniform %Lg,%Lg", low, high), numbers);
+}
+#endif
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Integers: ryu::Itoa64/Atoi64 vs. std::to_chars/from_chars
+//--------------------------------------------------------------------------------------------------
+
+#if BENCH_INTEGER()
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#define BENCH_INTEGER_CHARCONV() 1
+#endif
+#endif
+#ifndef BENCH_INTEGER_CHARCONV
+#define BENCH_INTEGER_CHARCONV() 0
+#endif
+
+struct I2SRyu
+{
+    char* operator()(char* buf, int64_t value) const { return ryu::Itoa64(buf, value); }
+};
+
+struct I2SPrintf
+{
+    char* operator()(char* buf, int64_t value) const { return buf + std::snprintf(buf, BufSize, "%lld", static_cast<long long>(value)); }
+};
+
+#if BENCH_INTEGER_CHARCONV()
+struct I2SCharconv
+{
+    char* operator()(char* buf, int64_t value) const { return std::to_chars(buf, buf + BufSize, value).ptr; }
+};
+#endif
+
+struct S2IRyu
+{
+    int64_t operator()(const char* first, const char* last) const { int64_t value = 0; ryu::Atoi64(first, last, value); return value; }
+};
+
+struct S2IStrtoll
+{
+    int64_t operator()(const char* first, const char* /*last*/) const { return std::strtoll(first, nullptr, 10); }
+};
+
+#if BENCH_INTEGER_CHARCONV()
+struct S2ICharconv
+{
+    int64_t operator()(const char* first, const char* last) const { int64_t value = 0; std::from_chars(first, last, value); return value; }
+};
+#endif
+
+template <typename I2S>
+static inline void BenchItoa(benchmark::State& state, std::vector<int64_t> const& numbers)
+{
+    I2S i2s;
+
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        for (const int64_t value : numbers)
+        {
+            char buffer[BufSize];
+            char* end = i2s(buffer, value);
+            sum += static_cast<size_t>(end - buffer);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+
+    if (sum == 0)
+        abort();
+}
+
+// strings holds the null-terminated inputs, each occupying BufSize bytes.
+template <typename S2I>
+static inline void BenchAtoi(benchmark::State& state, std::vector<char> const& strings, std::vector<int> const& lengths)
+{
+    S2I s2i;
+
+    uint64_t sum = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < lengths.size(); ++i)
+        {
+            const char* first = strings.data() + i * BufSize;
+            sum += static_cast<uint64_t>(s2i(first, first + lengths[i]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lengths.size()));
+
+    if (sum == 0)
+        abort();
+}
+
+static inline void Register_Integer(const char* name, std::vector<int64_t> const& numbers)
+{
+    std::vector<char> strings(numbers.size() * BufSize);
+    std::vector<int> lengths(numbers.size());
+    for (size_t i = 0; i < numbers.size(); ++i)
+    {
+        char* first = strings.data() + i * BufSize;
+        char* last = ryu::Itoa64(first, numbers[i]);
+        *last = '\0';
+        lengths[i] = static_cast<int>(last - first);
+    }
+
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - Itoa64        ", name), BenchItoa<I2SRyu>, numbers);
+#if BENCH_INTEGER_CHARCONV()
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - to_chars      ", name), BenchItoa<I2SCharconv>, numbers);
+#endif
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - printf        ", name), BenchItoa<I2SPrintf>, numbers);
+
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - Atoi64        ", name), BenchAtoi<S2IRyu>, strings, lengths);
+#if BENCH_INTEGER_CHARCONV()
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - from_chars    ", name), BenchAtoi<S2ICharconv>, strings, lengths);
+#endif
+    benchmark::RegisterBenchmark(StrPrintf("int64 - %s - strtoll       ", name), BenchAtoi<S2IStrtoll>, strings, lengths);
+}
+
+// Random numbers with the given number of decimal digits and a random sign.
+static inline void Register_Integer_Digits(int num_digits)
+{
+    std::vector<int64_t> numbers(static_cast<size_t>(NumFloats));
+
+    const int64_t lo = num_digits == 1 ? 0 : kPow10_i64[num_digits - 1];
+    const int64_t hi = num_digits == 19 ? INT64_MAX : kPow10_i64[num_digits] - 1;
+
+    std::uniform_int_distribution<int64_t> gen(lo, hi);
+    std::generate(numbers.begin(), numbers.end(), [&] { return (rng() & 1) ? -gen(rng) : gen(rng); });
+
+    Register_Integer(StrPrintf("%2d digits", num_digits), numbers);
+}
+
+static inline void Register_Integer_RandomBits()
+{
+    std::vector<int64_t> numbers(static_cast<size_t>(NumFloats));
+
+    std::uniform_int_distribution<uint64_t> gen(0, UINT64_MAX);
+    std::generate(numbers.begin(), numbers.end(), [&] { return static_cast<int64_t>(gen(rng)); });
+
+    Register_Integer("random bits", numbers);
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// ryu::Round10 vs. ryu::Round10Batch
+//--------------------------------------------------------------------------------------------------
+
+#if BENCH_ROUND10()
+static inline void BenchRound10(benchmark::State& state, std::vector<double> const& numbers, int n)
+{
+    std::vector<double> results(numbers.size());
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < numbers.size(); ++i)
+        {
+            results[i] = ryu::Round10(numbers[i], n);
+        }
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+
+static inline void BenchRound10Batch(benchmark::State& state, std::vector<double> const& numbers, int n)
+{
+    std::vector<double> results(numbers.size());
+
+    for (auto _ : state)
+    {
+        ryu::Round10Batch(numbers.data(), results.data(), numbers.size(), n);
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+
+static inline void BenchDtoaRound10(benchmark::State& state, std::vector<double> const& numbers, int n)
+{
+    char buf[ryu::DtoaMinBufferLength];
+
+    for (auto _ : state)
+    {
+        for (const double value : numbers)
+        {
+            char* end = ryu::Dtoa(buf, ryu::Round10(value, n));
+            benchmark::DoNotOptimize(end);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+
+static inline void BenchDtoaRounded(benchmark::State& state, std::vector<double> const& numbers, int n)
+{
+    char buf[ryu::DtoaMinBufferLength];
+
+    for (auto _ : state)
+    {
+        for (const double value : numbers)
+        {
+            char* end = ryu::DtoaRounded(buf, value, -n);
+            benchmark::DoNotOptimize(end);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+
+static inline void Register_Round10(const char* name, std::vector<double> const& numbers)
+{
+    for (const int n : {-2, -4})
+    {
+        benchmark::RegisterBenchmark(StrPrintf("Round10 - %s - n=%d - Round10      ", name, n), BenchRound10, numbers, n);
+        benchmark::RegisterBenchmark(StrPrintf("Round10 - %s - n=%d - Round10Batch ", name, n), BenchRound10Batch, numbers, n);
+        benchmark::RegisterBenchmark(StrPrintf("Round10 - %s - n=%d - Dtoa(Round10)", name, n), BenchDtoaRound10, numbers, n);
+        benchmark::RegisterBenchmark(StrPrintf("Round10 - %s - n=%d - DtoaRounded  ", name, n), BenchDtoaRounded, numbers, n);
+    }
+}
+
+static inline void Register_Round10_Uniform(double low, double high)
+{
+    std::vector<double> numbers(static_cast<size_t>(NumFloats));
+
+    std::uniform_real_distribution<double> gen(low, high);
+    std::generate(numbers.begin(), numbers.end(), [&] { return gen(rng); });
+
+    Register_Round10(StrPrintf("uniform %g/%g", low, high), numbers);
+}
+
+// Numbers with 3 decimal places, e.g. prices. Rounding these to 2 decimal places hits many ties.
+static inline void Register_Round10_Decimals()
+{
+    std::vector<double> numbers(static_cast<size_t>(NumFloats));
+
+    std::uniform_int_distribution<int64_t> gen(0, 100000000);
+    std::generate(numbers.begin(), numbers.end(), [&] { return static_cast<double>(gen(rng)) / 1000; });
+
+    Register_Round10("3 decimals", numbers);
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 //
 //--------------------------------------------------------------------------------------------------
@@ -503,6 +924,39 @@ int main(int argc, char** argv)
 
 #endif // BENCH_SINGLE()
 
+#if BENCH_HALF()
+
+    Register_Half("warm", NumFloats, false);
+    Register_Half("cold", 256, true);
+
+#endif // BENCH_HALF()
+
+#if BENCH_LONG_DOUBLE() && SCHUBFACH_LONG_DOUBLE80
+
+    Register_LongDouble_RandomBits();
+    Register_LongDouble_Uniform(0.0L, 1.0L);
+    Register_LongDouble_Uniform(0.0L, 1.0e+4000L);
+
+#endif // BENCH_LONG_DOUBLE()
+
+#if BENCH_INTEGER()
+
+    Register_Integer_RandomBits();
+    for (int d = 1; d <= 19; d += 3)
+    {
+        Register_Integer_Digits(d);
+    }
+
+#endif // BENCH_INTEGER()
+
+#if BENCH_ROUND10()
+
+    Register_Round10_Uniform(0.0, 1.0);
+    Register_Round10_Uniform(0.0, 1.0e+6);
+    Register_Round10_Decimals();
+
+#endif // BENCH_ROUND10()
+
     printf("Benchmarking %s\n", D2S::Name());
 
     benchmark::Initialize(&argc, argv);
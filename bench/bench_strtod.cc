@@ -9,6 +9,7 @@
 #include "ryu_64.h"
 
 #define BENCH_RYU()                 1
+#define BENCH_RYU_CACHED()          1
 #define BENCH_STD_STRTOD()          0
 #define BENCH_STD_CHARCONV()        0
 #define BENCH_DOUBLE_CONVERSION()   0
@@ -30,6 +31,21 @@ struct S2DRyu
 };
 #endif
 
+#if BENCH_RYU_CACHED()
+struct S2DRyuCached
+{
+    using value_type = double;
+
+    value_type operator()(std::string const& str) const
+    {
+        value_type flt = 0;
+        const auto res = ryu::CachedStrtod(str.data(), str.data() + str.size(), flt);
+        assert(res.status != ryu::StrtodStatus::invalid);
+        return flt;
+    }
+};
+#endif
+
 #if BENCH_STD_STRTOD()
 struct S2DStdStrtod
 {
@@ -141,7 +157,7 @@ public:
     uint32_t operator()() { return Gen(); }
 };
 
-static JenkinsRandom random;
+static JenkinsRandom rng;
 
 template <typename ...Args>
 static inline char const* StrPrintf(char const* format, Args&&... args)
@@ -155,6 +171,25 @@ static inline char const* StrPrintf(char const* format, Args&&... args)
 #endif
 }
 
+static inline void RegisterConverters(char const* name, std::vector<std::string> const& numbers)
+{
+#if BENCH_RYU()
+    RegisterBenchmarks<S2DRyu             >(StrPrintf("%s Ryu               ", name), numbers);
+#endif
+#if BENCH_RYU_CACHED()
+    RegisterBenchmarks<S2DRyuCached       >(StrPrintf("%s Ryu (cached)      ", name), numbers);
+#endif
+#if BENCH_STD_STRTOD()
+    RegisterBenchmarks<S2DStdStrtod       >(StrPrintf("%s std::strtod       ", name), numbers);
+#endif
+#if BENCH_STD_CHARCONV()
+    RegisterBenchmarks<S2DStdCharconv     >(StrPrintf("%s std::charconv     ", name), numbers);
+#endif
+#if BENCH_DOUBLE_CONVERSION()
+    RegisterBenchmarks<S2DDoubleConversion>(StrPrintf("%s double_conversion ", name), numbers);
+#endif
+}
+
 static inline void RegisterUniform_double(char const* name, double min, double max)
 {
     std::vector<std::string> numbers(NumFloats);
@@ -164,28 +199,93 @@ static inline void RegisterUniform_double(char const* name, double min, double m
     std::generate(numbers.begin(), numbers.end(), [&] {
         char buf[128];
 
-        char* const end = ryu::Dtoa(buf, gen(random));
-        //char* const end = buf + std::snprintf(buf, 128, "%.17g", gen(random));
-        //char* const end = buf + std::snprintf(buf, 128, "%.19g", gen(random));
-        //char* const end = buf + std::snprintf(buf, 128, "%.20g", gen(random));
+        char* const end = ryu::Dtoa(buf, gen(rng));
+        //char* const end = buf + std::snprintf(buf, 128, "%.17g", gen(rng));
+        //char* const end = buf + std::snprintf(buf, 128, "%.19g", gen(rng));
+        //char* const end = buf + std::snprintf(buf, 128, "%.20g", gen(rng));
 
         return std::string(buf, end);
     });
 
+    RegisterConverters(name, numbers);
+}
+
+// A few literal tokens make up `percent_common` percent of the input; the rest are short random
+// integers and decimals.
+static inline void RegisterSkewed_double(char const* name, int percent_common)
+{
+    static const char* const Common[] = {"0", "1", "0.0", "100", "-1", "NaN"};
+
+    std::vector<std::string> numbers(NumFloats);
+
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> common(0, static_cast<int>(sizeof(Common) / sizeof(Common[0])) - 1);
+    std::uniform_int_distribution<int> integer(-99999, 99999);
+
+    std::generate(numbers.begin(), numbers.end(), [&] {
+        if (percent(rng) < percent_common)
+            return std::string(Common[common(rng)]);
+
+        const int i = integer(rng);
+        return (i & 1) ? std::to_string(i) : std::to_string(i) + "e-2";
+    });
+
+    RegisterConverters(name, numbers);
+}
+
 #if BENCH_RYU()
-    RegisterBenchmarks<S2DRyu             >(StrPrintf("%s Ryu               ", name), numbers);
-#endif
-#if BENCH_STD_STRTOD()
-    RegisterBenchmarks<S2DStdStrtod       >(StrPrintf("%s std::strtod       ", name), numbers);
-#endif
-#if BENCH_STD_CHARCONV()
-    RegisterBenchmarks<S2DStdCharconv     >(StrPrintf("%s std::charconv     ", name), numbers);
-#endif
-#if BENCH_DOUBLE_CONVERSION()
-    RegisterBenchmarks<S2DDoubleConversion>(StrPrintf("%s double_conversion ", name), numbers);
-#endif
+// Scan each line byte by byte to find the token boundaries, then convert the token.
+static void BenchCSVScalar(benchmark::State& state, std::string const& csv)
+{
+    std::vector<double> values(NumFloats);
+
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        const char* first = csv.data();
+        const char* const last = csv.data() + csv.size();
+        while (first != last)
+        {
+            const char* p = first;
+            while (p != last && *p != ',' && *p != '\n')
+                ++p;
+            ryu::Strtod(first, p, values[count++]);
+            first = (p == last) ? p : p + 1;
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
 }
 
+static void BenchCSVBatch(benchmark::State& state, std::string const& csv)
+{
+    std::vector<double> values(NumFloats);
+
+    for (auto _ : state)
+    {
+        const size_t count = ryu::StrtodBatch(csv.data(), csv.data() + csv.size(), ',', values.data(), values.size());
+        benchmark::DoNotOptimize(count);
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+
+static inline void RegisterCSV_double(char const* name, double min, double max)
+{
+    std::string csv;
+
+    std::uniform_real_distribution<double> gen(min, max);
+    for (int i = 0; i < NumFloats; ++i)
+    {
+        char buf[128];
+        char* const end = ryu::Dtoa(buf, gen(rng));
+        csv.append(buf, end);
+        csv += (i % 8 == 7) ? '\n' : ',';
+    }
+
+    benchmark::RegisterBenchmark(StrPrintf("%s Ryu (scalar scan) ", name), BenchCSVScalar, csv);
+    benchmark::RegisterBenchmark(StrPrintf("%s Ryu (StrtodBatch) ", name), BenchCSVBatch, csv);
+}
+#endif
+
 int main(int argc, char** argv)
 {
 #if defined(__clang__)
@@ -212,6 +312,15 @@ int main(int argc, char** argv)
     RegisterUniform_double("uniform [2^20,2^50]", 1ll << 20, 1ll << 50);
     RegisterUniform_double("uniform [0,max]", 0.0, std::numeric_limits<double>::max());
 
+    RegisterSkewed_double("skewed 0%", 0);
+    RegisterSkewed_double("skewed 40%", 40);
+    RegisterSkewed_double("skewed 90%", 90);
+
+#if BENCH_RYU()
+    RegisterCSV_double("csv [0,1]", 0.0, 1.0);
+    RegisterCSV_double("csv [0,max]", 0.0, std::numeric_limits<double>::max());
+#endif
+
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
 
@@ -0,0 +1,120 @@
+#===============================================================================
+# Generates the tables E4M3Strings and E5M2Strings for fp8.cc
+#
+# Usage: python3 gen_fp8_tables.py > tables.inc
+#
+# For each 8-bit number, the table contains the shortest decimal number which
+# rounds back to the input (ties to even), and the one closest to the input if
+# there are several such numbers (the even one on ties). All computations use
+# exact rational arithmetic. All finite numbers are printed in fixed notation,
+# which is what FormatDigits in schubfach_16.cc produces for numbers in this
+# range.
+#===============================================================================
+
+from fractions import Fraction
+
+class Format:
+    def __init__(self, name, significand_size, exponent_bias, has_inf):
+        self.name = name
+        self.significand_size = significand_size # = p (includes the hidden bit)
+        self.exponent_bias = exponent_bias
+        self.has_inf = has_inf
+
+E4M3 = Format('E4M3', 4,  7, False)
+E5M2 = Format('E5M2', 3, 15, True)
+
+def Decode(fmt, bits):
+    # Returns (is_nan, is_inf, f, e), such that the magnitude of the number is f * 2^e.
+    p = fmt.significand_size
+    F = bits & ((1 << (p - 1)) - 1)
+    E = (bits & 0x7F) >> (p - 1)
+    max_exponent = 0xFF >> p
+    if fmt.has_inf:
+        if E == max_exponent:
+            return (F != 0, F == 0, 0, 0)
+    else:
+        if (bits & 0x7F) == 0x7F:
+            return (True, False, 0, 0)
+    if E == 0:
+        return (False, False, F, 1 - fmt.exponent_bias - (p - 1))
+    return (False, False, F | (1 << (p - 1)), E - fmt.exponent_bias - (p - 1))
+
+def RoundingInterval(fmt, f, e):
+    # Returns f * 2^e and the boundaries of its rounding interval.
+    # The boundaries are included iff f is even.
+    p = fmt.significand_size
+    min_exponent = 1 - fmt.exponent_bias - (p - 1)
+    lower_boundary_is_closer = (f == (1 << (p - 1)) and e > min_exponent)
+
+    v = Fraction(f) * Fraction(2)**e
+    lower = v - (Fraction(2)**e / 4 if lower_boundary_is_closer else Fraction(2)**e / 2)
+    upper = v + Fraction(2)**e / 2
+    return v, lower, upper
+
+def InInterval(x, lower, upper, closed):
+    if closed:
+        return lower <= x <= upper
+    return lower < x < upper
+
+def Shortest(fmt, f, e):
+    v, lower, upper = RoundingInterval(fmt, f, e)
+    closed = (f % 2 == 0)
+    # Find the smallest number of significant digits n, such that the interval
+    # contains a number c * 10^(k - n + 1) with n digits.
+    k = 0
+    while Fraction(10)**k <= v:
+        k += 1
+    while Fraction(10)**k > v:
+        k -= 1
+    # 10^k <= v < 10^(k+1)
+    for n in range(1, 20):
+        scale = Fraction(10)**(k - n + 1)
+        candidates = []
+        d = int(lower / scale)
+        for c in range(max(d - 1, 1), d + int((upper - lower) / scale) + 3):
+            if InInterval(c * scale, lower, upper, closed):
+                candidates.append(c)
+        if candidates:
+            # The closest candidate, and the even one if there are two.
+            c = min(candidates, key=lambda c: (abs(c * scale - v), c % 2))
+            return c * scale
+    assert False
+
+def FormatFixed(x):
+    # x is a positive rational with a terminating decimal expansion.
+    s = 0
+    while (x * 10**s).denominator != 1:
+        s += 1
+    digits = str(int(x * 10**s))
+    if s == 0:
+        return digits
+    if len(digits) <= s:
+        digits = '0' * (s - len(digits) + 1) + digits
+    return digits[:-s] + '.' + digits[-s:]
+
+def ToString(fmt, bits):
+    is_nan, is_inf, f, e = Decode(fmt, bits)
+    sign = '-' if (bits & 0x80) else ''
+    if is_nan:
+        return 'nan'
+    if is_inf:
+        return sign + 'inf'
+    if f == 0:
+        return sign + '0'
+    return sign + FormatFixed(Shortest(fmt, f, e))
+
+def PrintTable(fmt):
+    print('static constexpr ShortestString {}Strings[256] = {{'.format(fmt.name))
+    for row in range(0, 256, 4):
+        line = '        '
+        for bits in range(row, row + 4):
+            s = ToString(fmt, bits)
+            entry = '{{"{}", {}}},'.format(s, len(s))
+            line += entry if bits == row + 3 else entry.ljust(18)
+        line += ' // 0x{:02X}'.format(row)
+        print(line)
+    print('};')
+
+PrintTable(E4M3)
+print('')
+PrintTable(E5M2)
@@ -0,0 +1,77 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+// Generates the lookup table for schubfach::HtoaTable.
+//
+// Usage: gen_half_table <output file>
+//
+// For each non-negative binary16 number, the table contains the output of schubfach::Htoa,
+// stored in a packed blob of characters. The output for negative numbers is the same, except for
+// the leading '-'.
+
+#include "schubfach_16.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<uint32_t> entries;
+    std::string blob;
+
+    for (uint32_t bits = 0; bits <= 0x7FFF; ++bits)
+    {
+        char buf[schubfach::HtoaMinBufferLength];
+        char* const end = schubfach::Htoa(buf, static_cast<uint16_t>(bits));
+
+        const uint32_t length = static_cast<uint32_t>(end - buf);
+        const uint32_t offset = static_cast<uint32_t>(blob.size());
+        if (length > 15 || offset >= (1u << 28))
+        {
+            std::fprintf(stderr, "table entry out of range\n");
+            return 1;
+        }
+
+        entries.push_back(offset << 4 | length);
+        blob.append(buf, end);
+    }
+
+    FILE* file = std::fopen(argv[1], "w");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::fprintf(file, "// Generated by scripts/gen_half_table.cc. Do not edit.\n\n");
+
+    // Entry = offset << 4 | length
+    std::fprintf(file, "static constexpr uint32_t HalfTableEntries[%zu] = {\n", entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        std::fprintf(file, "%s0x%08X,%s", (i % 8 == 0) ? "    " : "", entries[i], (i % 8 == 7) ? "\n" : " ");
+    }
+    std::fprintf(file, "};\n\n");
+
+    // Pad the blob, so that 16 bytes can always be copied.
+    blob.append(16, '\0');
+
+    std::fprintf(file, "static constexpr char HalfTableBlob[%zu] = {\n", blob.size());
+    for (size_t i = 0; i < blob.size(); ++i)
+    {
+        std::fprintf(file, "%s%d,%s", (i % 24 == 0) ? "    " : "", blob[i], (i % 24 == 23 || i + 1 == blob.size()) ? "\n" : "");
+    }
+    std::fprintf(file, "};\n");
+
+    return std::fclose(file) == 0 ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#===============================================================================
+# Computes the table of 256-bit powers of ten for schubfach_128.cc
+#
+# There are unique beta and r such that 10^k = beta 2^r and 2^255 <= beta < 2^256,
+# namely r = floor(log_2 10^k) - 255 and beta = 2^-r 10^k.
+# The table contains g = ceil(beta), split into four 64-bit words.
+#===============================================================================
+
+def FloorLog2Pow10(k):
+    # Exact.
+    if k >= 0:
+        return (10**k).bit_length() - 1
+    else:
+        return -(10**-k).bit_length()
+
+def FloorLog2Pow10Approx(k):
+    # The approximation used in schubfach_128.cc.
+    assert k >= -5100
+    assert k <=  5100
+    return (k * 14267572527) >> 32
+
+def CeilDiv(num, den):
+    return (num + (den - 1)) // den
+
+def ComputeG(k):
+    r = FloorLog2Pow10(k) - 255
+    if k >= 0:
+        if r >= 0:
+            return CeilDiv(10**k, 2**r)
+        else:
+            return 10**k * 2**-r
+    else:
+        return CeilDiv(2**-r, 10**-k)
+
+def PrintTable(k_min, k_max):
+    for k in range(k_min, k_max + 1):
+        assert FloorLog2Pow10(k) == FloorLog2Pow10Approx(k)
+        g = ComputeG(k)
+        assert 2**255 <= g < 2**256
+        w = [(g >> (64 * i)) & (2**64 - 1) for i in reversed(range(4))]
+        print('        {{0x{:016X}, 0x{:016X}, 0x{:016X}, 0x{:016X}}}, // {:5d}'.format(w[0], w[1], w[2], w[3], k))
+
+# k_min: required by the decimal to binary conversion (38 digits at 10^-5003).
+# k_max: required by the binary to decimal conversion, -floor(log_10(3/4 2^-16494)).
+PrintTable(-5003, 4966)
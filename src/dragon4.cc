@@ -49,7 +49,8 @@ static inline void Memmove(uint32_t* dst, const uint32_t* src, int n)
 namespace {
 struct DiyInt
 {
-    static constexpr int MaxBits = 1130;
+    // Large enough for binary128. (1130 bits are sufficient for binary64.)
+    static constexpr int MaxBits = 16704;
     static constexpr int Capacity = (MaxBits + (32 - 1)) / 32;
 
     uint32_t bigits[Capacity]; // Significand stored in little-endian form.
@@ -315,6 +316,20 @@ static inline void AssignPow2MulPow5(DiyInt& x, int e2, int e5)
     //MulPow2(x, e2);
 }
 
+#if defined(__SIZEOF_INT128__)
+__extension__ using uint128_t = unsigned __int128;
+
+static inline void AssignU128(DiyInt& x, uint128_t value)
+{
+    x.size = 0;
+    for ( ; value != 0; value >>= 32)
+    {
+        DRAGON4_ASSERT(x.size < 4);
+        x.bigits[x.size++] = static_cast<uint32_t>(value);
+    }
+}
+#endif
+
 // Returns the number of leading 0-bits in x, starting at the most significant bit position.
 // If x is 0, the result is undefined.
 static inline int CountLeadingZeros32(uint32_t x)
@@ -494,7 +509,8 @@ static inline uint32_t DivMod(DiyInt& u, const DiyInt& v)
         DRAGON4_ASSERT(qp > 0);
         qp--;
     }
-    DRAGON4_ASSERT(qp <= 9);
+    // q' is now either q or q + 1, i.e. q' might still be 10 here. This is fixed in step D6.
+    DRAGON4_ASSERT(qp <= 10);
 
     //--------------------------------------------------------------------------
     // D4. [Multiply and subtract.]
@@ -571,6 +587,7 @@ static inline uint32_t DivMod(DiyInt& u, const DiyInt& v)
         // vn = 0:
         u.bigits[n] += carry;
     }
+    DRAGON4_ASSERT(qp <= 9);
 
     //--------------------------------------------------------------------------
     // D7. [Loop on j.]
@@ -789,21 +806,18 @@ static inline int ComputeInitialValuesAndEstimate(DiyInt& r, DiyInt& s, DiyInt&
 
 void dragon4::Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool accept_bounds, bool lower_boundary_is_closer)
 {
-    DiyInt r;
-    DiyInt s;
-    DiyInt delta;
-
-    //
-    // Compute initial values.
-    // Estimate k.
-    //
-    int k = ComputeInitialValuesAndEstimate(r, s, delta, f, e, lower_boundary_is_closer);
+    Dragon4(digits, exponent, f, e, accept_bounds, accept_bounds, lower_boundary_is_closer);
+}
 
+// Generates the shortest digits, given the initial values r, s, delta and the estimate k.
+template <typename UInt>
+static inline void GenerateShortestDigits(UInt& digits, int& exponent, DiyInt& r, DiyInt& s, DiyInt& delta, int k, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer)
+{
     //
     // Fixup, in case k is too low.
     //
     const int cmpf = CompareAdd(r, delta, s);
-    if (accept_bounds ? (cmpf >= 0) : (cmpf > 0))
+    if (accept_upper ? (cmpf >= 0) : (cmpf > 0))
     {
         Mul10(s);
         k++;
@@ -815,10 +829,10 @@ void dragon4::Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool a
     Mul10(r);       // (Move into init step above?)
     Mul10(delta);   // (Move into init step above?)
 
-    uint64_t d10 = 0;
+    UInt d10 = 0;
     for (;;)
     {
-        DRAGON4_ASSERT(d10 <= 9999999999999999ull);
+        DRAGON4_ASSERT(d10 <= static_cast<UInt>(~UInt{0}) / 10 - 1);
         DRAGON4_ASSERT(r.size > 0);
 
         // q = r / s
@@ -833,8 +847,8 @@ void dragon4::Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool a
         }
         const int cmp2 = CompareAdd(r, delta, s);
 
-        const bool tc1 = accept_bounds ? (cmp1 <= 0) : (cmp1 < 0);
-        const bool tc2 = accept_bounds ? (cmp2 >= 0) : (cmp2 > 0);
+        const bool tc1 = accept_lower ? (cmp1 <= 0) : (cmp1 < 0);
+        const bool tc2 = accept_upper ? (cmp2 >= 0) : (cmp2 > 0);
         if (tc1 && tc2)
         {
             // Return the number closer to v.
@@ -865,3 +879,97 @@ void dragon4::Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool a
     digits = d10;
     exponent = k;
 }
+
+void dragon4::Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer)
+{
+    DiyInt r;
+    DiyInt s;
+    DiyInt delta;
+
+    //
+    // Compute initial values.
+    // Estimate k.
+    //
+    const int k = ComputeInitialValuesAndEstimate(r, s, delta, f, e, lower_boundary_is_closer);
+
+    GenerateShortestDigits(digits, exponent, r, s, delta, k, accept_lower, accept_upper, lower_boundary_is_closer);
+}
+
+#if defined(__SIZEOF_INT128__)
+
+static inline int EffectivePrecision(uint128_t f)
+{
+    DRAGON4_ASSERT(f != 0);
+
+    const uint64_t hi = static_cast<uint64_t>(f >> 64);
+    return hi != 0 ? 128 - CountLeadingZeros64(hi) : EffectivePrecision(static_cast<uint64_t>(f));
+}
+
+// Returns: ceil(log_10(2^e))
+static inline int CeilLog10Pow2_Wide(int e)
+{
+    DRAGON4_ASSERT(e >= -16600);
+    DRAGON4_ASSERT(e <=  16600);
+    return static_cast<int>((int64_t{e} * 1292913986 + ((int64_t{1} << 32) - 1)) >> 32);
+}
+
+static inline int ComputeInitialValuesAndEstimate(DiyInt& r, DiyInt& s, DiyInt& delta, uint128_t f, int e, bool lower_boundary_is_closer)
+{
+    const int boundary_shift = lower_boundary_is_closer ? 2 : 1;
+    const int p = EffectivePrecision(f);
+    DRAGON4_ASSERT(p >= 1);
+    DRAGON4_ASSERT(p <= 113);
+    const int k = CeilLog10Pow2_Wide(e + (p - 1));
+
+    if (e >= 0)
+    {
+        DRAGON4_ASSERT(e + p <= 16384); // f 2^e < 2^16384 (binary128 or x87 extended precision)
+
+        // r = f * 2^(boundary_shift + e)
+        AssignU128(r, f << boundary_shift);
+        MulPow2(r, e);
+        // s = 2^boundary_shift * 10^k
+        AssignPow2MulPow5(s, boundary_shift + k, k);
+        // delta = 2^e
+        AssignPow2(delta, e);
+    }
+    else if (k < 0)
+    {
+        DRAGON4_ASSERT(e >= -16494);
+
+        // r = f * 2^boundary_shift * 10^(-k)
+        AssignU128(r, f << boundary_shift);
+        MulPow5(r, -k);
+        MulPow2(r, -k);
+        // s = 2^(boundary_shift - e)
+        AssignPow2(s, boundary_shift - e);
+        // delta = 10^(-k)
+        AssignPow10(delta, -k);
+    }
+    else
+    {
+        DRAGON4_ASSERT(e >= -116);
+
+        // r = f * 2^boundary_shift
+        AssignU128(r, f << boundary_shift);
+        // s = 2^(boundary_shift - e) * 10^k
+        AssignPow2MulPow5(s, boundary_shift - e + k, k);
+        // delta = 1
+        AssignU32(delta, 1);
+    }
+
+    return k;
+}
+
+void dragon4::Dragon4(uint128_t& digits, int& exponent, uint128_t f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer)
+{
+    DiyInt r;
+    DiyInt s;
+    DiyInt delta;
+
+    const int k = ComputeInitialValuesAndEstimate(r, s, delta, f, e, lower_boundary_is_closer);
+
+    GenerateShortestDigits(digits, exponent, r, s, delta, k, accept_lower, accept_upper, lower_boundary_is_closer);
+}
+
+#endif
@@ -11,4 +11,11 @@ namespace dragon4 {
 
 void Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool accept_bounds, bool lower_boundary_is_closer);
 
+void Dragon4(uint64_t& digits, int& exponent, uint64_t f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer);
+
+#if defined(__SIZEOF_INT128__)
+// Same as above, but for significands with up to 113 bits, i.e. for all IEEE binary128 numbers.
+void Dragon4(unsigned __int128& digits, int& exponent, unsigned __int128 f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer);
+#endif
+
 } // namespace dragon4
@@ -12,8 +12,7 @@
 // It is a simplified version of the reference implementation found here:
 // https://github.com/jk-jeon/dragonbox
 //
-// The reference implementation also works with single-precision floating-point numbers and
-// has options to configure the rounding mode.
+// The reference implementation has options to configure the rounding mode.
 //--------------------------------------------------------------------------------------------------
 
 #include <cassert>
@@ -97,6 +96,42 @@ struct Double
         return (bits & SignMask) != 0;
     }
 };
+
+struct Single
+{
+    static_assert(std::numeric_limits<float>::is_iec559
+               && std::numeric_limits<float>::digits == 24
+               && std::numeric_limits<float>::max_exponent == 128,
+        "IEEE-754 single-precision implementation required");
+
+    using value_type = float;
+    using bits_type = uint32_t;
+
+    static constexpr int32_t   SignificandSize = std::numeric_limits<value_type>::digits; // = p   (includes the hidden bit)
+    static constexpr int32_t   ExponentBias    = std::numeric_limits<value_type>::max_exponent - 1 + (SignificandSize - 1);
+    static constexpr bits_type MaxIeeeExponent = bits_type{2 * std::numeric_limits<value_type>::max_exponent - 1};
+    static constexpr bits_type HiddenBit       = bits_type{1} << (SignificandSize - 1);   // = 2^(p-1)
+    static constexpr bits_type SignificandMask = HiddenBit - 1;                           // = 2^(p-1) - 1
+    static constexpr bits_type ExponentMask    = MaxIeeeExponent << (SignificandSize - 1);
+    static constexpr bits_type SignMask        = ~(~bits_type{0} >> 1);
+
+    bits_type bits;
+
+    explicit Single(bits_type bits_) : bits(bits_) {}
+    explicit Single(value_type value) : bits(ReinterpretBits<bits_type>(value)) {}
+
+    bits_type PhysicalSignificand() const {
+        return bits & SignificandMask;
+    }
+
+    bits_type PhysicalExponent() const {
+        return (bits & ExponentMask) >> (SignificandSize - 1);
+    }
+
+    bool SignBit() const {
+        return (bits & SignMask) != 0;
+    }
+};
 } // namespace
 
 //==================================================================================================
@@ -779,6 +814,98 @@ static inline uint64x2 ComputePow10_Double(int32_t k)
     return Pow10[static_cast<uint32_t>(k - kMin)];
 }
 
+// Returns ceil(10^k 2^(63 - floor(log_2(10^k)))), i.e. the upper 64 bits of ComputePow10_Double(k),
+// rounded up.
+static inline uint64_t ComputePow10_Single(int32_t k)
+{
+    static constexpr int32_t kMin = -31;
+    static constexpr int32_t kMax =  46;
+    static constexpr uint64_t Pow10[kMax - kMin + 1] = {
+        0x81CEB32C4B43FCF5, // -31
+        0xA2425FF75E14FC32, // -30
+        0xCAD2F7F5359A3B3F, // -29
+        0xFD87B5F28300CA0E, // -28
+        0x9E74D1B791E07E49, // -27
+        0xC612062576589DDB, // -26
+        0xF79687AED3EEC552, // -25
+        0x9ABE14CD44753B53, // -24
+        0xC16D9A0095928A28, // -23
+        0xF1C90080BAF72CB2, // -22
+        0x971DA05074DA7BEF, // -21
+        0xBCE5086492111AEB, // -20
+        0xEC1E4A7DB69561A6, // -19
+        0x9392EE8E921D5D08, // -18
+        0xB877AA3236A4B44A, // -17
+        0xE69594BEC44DE15C, // -16
+        0x901D7CF73AB0ACDA, // -15
+        0xB424DC35095CD810, // -14
+        0xE12E13424BB40E14, // -13
+        0x8CBCCC096F5088CC, // -12
+        0xAFEBFF0BCB24AAFF, // -11
+        0xDBE6FECEBDEDD5BF, // -10
+        0x89705F4136B4A598, // -9
+        0xABCC77118461CEFD, // -8
+        0xD6BF94D5E57A42BD, // -7
+        0x8637BD05AF6C69B6, // -6
+        0xA7C5AC471B478424, // -5
+        0xD1B71758E219652C, // -4
+        0x83126E978D4FDF3C, // -3
+        0xA3D70A3D70A3D70B, // -2
+        0xCCCCCCCCCCCCCCCD, // -1
+        0x8000000000000000, // 0
+        0xA000000000000000, // 1
+        0xC800000000000000, // 2
+        0xFA00000000000000, // 3
+        0x9C40000000000000, // 4
+        0xC350000000000000, // 5
+        0xF424000000000000, // 6
+        0x9896800000000000, // 7
+        0xBEBC200000000000, // 8
+        0xEE6B280000000000, // 9
+        0x9502F90000000000, // 10
+        0xBA43B74000000000, // 11
+        0xE8D4A51000000000, // 12
+        0x9184E72A00000000, // 13
+        0xB5E620F480000000, // 14
+        0xE35FA931A0000000, // 15
+        0x8E1BC9BF04000000, // 16
+        0xB1A2BC2EC5000000, // 17
+        0xDE0B6B3A76400000, // 18
+        0x8AC7230489E80000, // 19
+        0xAD78EBC5AC620000, // 20
+        0xD8D726B7177A8000, // 21
+        0x878678326EAC9000, // 22
+        0xA968163F0A57B400, // 23
+        0xD3C21BCECCEDA100, // 24
+        0x84595161401484A0, // 25
+        0xA56FA5B99019A5C8, // 26
+        0xCECB8F27F4200F3A, // 27
+        0x813F3978F8940985, // 28
+        0xA18F07D736B90BE6, // 29
+        0xC9F2C9CD04674EDF, // 30
+        0xFC6F7C4045812297, // 31
+        0x9DC5ADA82B70B59E, // 32
+        0xC5371912364CE306, // 33
+        0xF684DF56C3E01BC7, // 34
+        0x9A130B963A6C115D, // 35
+        0xC097CE7BC90715B4, // 36
+        0xF0BDC21ABB48DB21, // 37
+        0x96769950B50D88F5, // 38
+        0xBC143FA4E250EB32, // 39
+        0xEB194F8E1AE525FE, // 40
+        0x92EFD1B8D0CF37BF, // 41
+        0xB7ABC627050305AE, // 42
+        0xE596B7B0C643C71A, // 43
+        0x8F7E32CE7BEA5C70, // 44
+        0xB35DBF821AE4F38C, // 45
+        0xE0352F62A19E306F, // 46
+    };
+
+    DRAGONBOX_ASSERT(k >= kMin);
+    DRAGONBOX_ASSERT(k <= kMax);
+    return Pow10[static_cast<uint32_t>(k - kMin)];
+}
+
 // Returns whether value is divisible by 2^e2
 static inline bool MultipleOfPow2(uint64_t value, int32_t e2)
 {
@@ -836,11 +963,27 @@ struct FloatingDecimal64 {
 };
 }
 
+using dragonbox::ReaderTies;
+
+// Returns whether the lower boundary of the rounding interval rounds to v when read in.
+static constexpr bool AcceptLowerBoundary(ReaderTies ties, bool is_even)
+{
+    return ties == ReaderTies::to_even ? is_even : ties == ReaderTies::away_from_zero;
+}
+
+// Returns whether the upper boundary of the rounding interval rounds to v when read in.
+static constexpr bool AcceptUpperBoundary(ReaderTies ties, bool is_even)
+{
+    return ties == ReaderTies::to_even ? is_even : ties == ReaderTies::toward_zero;
+}
+
+template <ReaderTies Ties>
 static inline FloatingDecimal64 ToDecimal64_asymmetric_interval(int32_t e2)
 {
     // NB:
-    // accept_lower_endpoint = true
-    // accept_upper_endpoint = true
+    // The significand is even here.
+    constexpr bool accept_lower = AcceptLowerBoundary(Ties, true);
+    constexpr bool accept_upper = AcceptUpperBoundary(Ties, true);
 
     static constexpr int32_t P = Double::SignificandSize;
 
@@ -854,12 +997,16 @@ static inline FloatingDecimal64 ToDecimal64_asymmetric_interval(int32_t e2)
     const uint64_t lower_endpoint = (pow10.hi - (pow10.hi >> (P + 1))) >> (64 - P - beta_minus_1);
     const uint64_t upper_endpoint = (pow10.hi + (pow10.hi >> (P + 0))) >> (64 - P - beta_minus_1);
 
-    // If we don't accept the left endpoint (but we do!) or
+    // If we don't accept the right endpoint and
+    // if the right endpoint is an integer, decrease it
+    const bool upper_endpoint_is_integer = (0 <= e2 && e2 <= 3);
+
+    // If we don't accept the left endpoint or
 	// if the left endpoint is not an integer, increase it
     const bool lower_endpoint_is_integer = (2 <= e2 && e2 <= 3);
 
-    const uint64_t xi = lower_endpoint + !lower_endpoint_is_integer;
-    const uint64_t zi = upper_endpoint;
+    const uint64_t xi = lower_endpoint + (!accept_lower || !lower_endpoint_is_integer);
+    const uint64_t zi = upper_endpoint - (!accept_upper && upper_endpoint_is_integer);
 
     // Try bigger divisor
     uint64_t q = zi / 10;
@@ -982,6 +1129,7 @@ static inline bool IsIntegralMidpoint(uint64_t two_f, int32_t e2, int32_t minus_
     return false;
 }
 
+template <ReaderTies Ties = ReaderTies::to_even>
 static inline FloatingDecimal64 ToDecimal64(const uint64_t ieee_significand, const uint64_t ieee_exponent)
 {
     static constexpr int32_t Kappa = 2;
@@ -1009,7 +1157,7 @@ static inline FloatingDecimal64 ToDecimal64(const uint64_t ieee_significand, con
         if /*unlikely*/ (ieee_significand == 0 && ieee_exponent > 1)
         {
             // Shorter interval case; proceed like Schubfach.
-            return ToDecimal64_asymmetric_interval(e2);
+            return ToDecimal64_asymmetric_interval<Ties>(e2);
         }
     }
     else
@@ -1020,8 +1168,8 @@ static inline FloatingDecimal64 ToDecimal64(const uint64_t ieee_significand, con
     }
 
     const bool is_even = (m2 % 2 == 0);
-    const bool accept_lower = is_even;
-    const bool accept_upper = is_even;
+    const bool accept_lower = AcceptLowerBoundary(Ties, is_even);
+    const bool accept_upper = AcceptUpperBoundary(Ties, is_even);
 
     // Compute k and beta.
     const int32_t minus_k = FloorLog10Pow2(e2) - Kappa;
@@ -1124,6 +1272,249 @@ static inline FloatingDecimal64 ToDecimal64(const uint64_t ieee_significand, con
     return {q, minus_k + Kappa};
 }
 
+//==================================================================================================
+// ToDecimal32
+//==================================================================================================
+
+namespace {
+struct FloatingDecimal32 {
+    uint32_t significand;
+    int32_t exponent;
+};
+}
+
+template <ReaderTies Ties>
+static inline FloatingDecimal32 ToDecimal32_asymmetric_interval(int32_t e2)
+{
+    // NB:
+    // The significand is even here.
+    constexpr bool accept_lower = AcceptLowerBoundary(Ties, true);
+    constexpr bool accept_upper = AcceptUpperBoundary(Ties, true);
+
+    static constexpr int32_t P = Single::SignificandSize;
+
+    // Compute k and beta
+    const int32_t minus_k = FloorLog10ThreeQuartersPow2(e2);
+    const int32_t beta_minus_1 = e2 + FloorLog2Pow10(-minus_k);
+
+    // Compute xi and zi
+    const uint64_t pow10 = ComputePow10_Single(-minus_k);
+
+    const uint32_t lower_endpoint = static_cast<uint32_t>((pow10 - (pow10 >> (P + 1))) >> (64 - P - beta_minus_1));
+    const uint32_t upper_endpoint = static_cast<uint32_t>((pow10 + (pow10 >> (P + 0))) >> (64 - P - beta_minus_1));
+
+    // If we don't accept the right endpoint and
+    // if the right endpoint is an integer, decrease it
+    const bool upper_endpoint_is_integer = (0 <= e2 && e2 <= 3);
+
+    // If we don't accept the left endpoint or
+    // if the left endpoint is not an integer, increase it
+    const bool lower_endpoint_is_integer = (2 <= e2 && e2 <= 3);
+
+    const uint32_t xi = lower_endpoint + (!accept_lower || !lower_endpoint_is_integer);
+    const uint32_t zi = upper_endpoint - (!accept_upper && upper_endpoint_is_integer);
+
+    // Try bigger divisor
+    uint32_t q = zi / 10;
+    if (q * 10 >= xi)
+    {
+        return {q, minus_k + 1};
+    }
+
+    // Otherwise, compute the round-up of y
+    q = static_cast<uint32_t>(((pow10 >> (64 - (P + 1) - beta_minus_1)) + 1) / 2);
+
+    // When tie occurs, choose one of them according to the rule
+    if (e2 == -35)
+    {
+        q -= (q % 2 != 0); // Round to even.
+    }
+    else
+    {
+        q += (q < xi);
+    }
+
+    return {q, minus_k};
+}
+
+static inline uint32_t ComputeDelta(uint64_t pow10, int32_t beta_minus_1)
+{
+    DRAGONBOX_ASSERT(beta_minus_1 >= 0);
+    DRAGONBOX_ASSERT(beta_minus_1 <= 63);
+    return static_cast<uint32_t>(pow10 >> (64 - 1 - beta_minus_1));
+}
+
+// Returns (x * y) / 2^64
+static inline uint32_t MulShift(uint32_t x, uint64_t y) // 1 mulx
+{
+    return static_cast<uint32_t>(Mul128(x, y).hi);
+}
+
+static inline bool MulParity(uint32_t two_f, uint64_t pow10, int32_t beta_minus_1) // 1 mul
+{
+    DRAGONBOX_ASSERT(beta_minus_1 >= 1);
+    DRAGONBOX_ASSERT(beta_minus_1 <= 63);
+
+    const uint64_t p = two_f * pow10;
+    return (p & (uint64_t{1} << (64 - beta_minus_1))) != 0;
+}
+
+static inline bool IsIntegralEndpoint(uint32_t two_f, int32_t e2, int32_t minus_k)
+{
+    if (e2 < -1)
+        return false;
+    if (e2 <= 6)
+        return true;
+    if (e2 <= 39)
+        return MultipleOfPow5(two_f, minus_k);
+
+    return false;
+}
+
+static inline bool IsIntegralMidpoint(uint32_t two_f, int32_t e2, int32_t minus_k)
+{
+    if (e2 < -2)
+        return MultipleOfPow2(two_f, minus_k - e2 + 1);
+    if (e2 <= 6)
+        return true;
+    if (e2 <= 39)
+        return MultipleOfPow5(two_f, minus_k);
+
+    return false;
+}
+
+// Same as ToDecimal64, but with kappa = 1 and 64-bit approximations of the powers of ten.
+template <ReaderTies Ties = ReaderTies::to_even>
+static inline FloatingDecimal32 ToDecimal32(const uint32_t ieee_significand, const uint32_t ieee_exponent)
+{
+    static constexpr int32_t Kappa = 1;
+    static constexpr uint32_t BigDivisor   = 100; // 10^(kappa + 1)
+    static constexpr uint32_t SmallDivisor = 10;  // 10^(kappa)
+
+    //
+    // Step 1:
+    // integer promotion & Schubfach multiplier calculation.
+    //
+
+    uint32_t m2;
+    int32_t  e2;
+    if (ieee_exponent != 0)
+    {
+        m2 = Single::HiddenBit | ieee_significand;
+        e2 = static_cast<int32_t>(ieee_exponent) - Single::ExponentBias;
+
+        if /*unlikely*/ (0 <= -e2 && -e2 < Single::SignificandSize && MultipleOfPow2(m2, -e2))
+        {
+            // Small integer.
+            return {m2 >> -e2, 0};
+        }
+
+        if /*unlikely*/ (ieee_significand == 0 && ieee_exponent > 1)
+        {
+            // Shorter interval case; proceed like Schubfach.
+            return ToDecimal32_asymmetric_interval<Ties>(e2);
+        }
+    }
+    else
+    {
+        // Subnormal case; interval is always regular.
+        m2 = ieee_significand;
+        e2 = 1 - Single::ExponentBias;
+    }
+
+    const bool is_even = (m2 % 2 == 0);
+    const bool accept_lower = AcceptLowerBoundary(Ties, is_even);
+    const bool accept_upper = AcceptUpperBoundary(Ties, is_even);
+
+    // Compute k and beta.
+    const int32_t minus_k = FloorLog10Pow2(e2) - Kappa;
+    const int32_t beta_minus_1 = e2 + FloorLog2Pow10(-minus_k);
+    DRAGONBOX_ASSERT(beta_minus_1 >= 3);
+    DRAGONBOX_ASSERT(beta_minus_1 <= 6);
+
+    const uint64_t pow10 = ComputePow10_Single(-minus_k);
+
+    // Compute delta
+    // 10^kappa <= delta < 10^(kappa + 1)
+    //       10 <= delta < 100
+    const uint32_t delta = ComputeDelta(pow10, beta_minus_1);
+    DRAGONBOX_ASSERT(delta >= SmallDivisor);
+    DRAGONBOX_ASSERT(delta <  BigDivisor  );
+
+    const uint32_t two_fl = 2 * m2 - 1;
+    const uint32_t two_fc = 2 * m2;
+    const uint32_t two_fr = 2 * m2 + 1; // (25 bits)
+
+    // Compute zi
+    //  (25 + 6 = 31 bits)
+    const uint32_t zi = MulShift(two_fr << beta_minus_1, pow10); // 1 mulx
+
+    //
+    // Step 2:
+    // Try larger divisor.
+    //
+
+    uint32_t q = zi / BigDivisor;
+    uint32_t r = zi - BigDivisor * q; // r = zi % BigDivisor
+    // 0 <= r < 100
+
+    if /*likely ~50% ?!*/ (r < delta)
+    {
+        // Exclude the right endpoint if necessary
+        if /*likely*/ (r != 0 || accept_upper || !IsIntegralEndpoint(two_fr, e2, minus_k))
+        {
+            return {q, minus_k + Kappa + 1};
+        }
+
+        DRAGONBOX_ASSERT(q != 0);
+        --q;
+        r = BigDivisor;
+    }
+    else if /*unlikely*/ (r == delta)
+    {
+        // Compare fractional parts.
+        if ((accept_lower && IsIntegralEndpoint(two_fl, e2, minus_k)) || MulParity(two_fl, pow10, beta_minus_1)) // 1 mul
+        {
+            return {q, minus_k + Kappa + 1};
+        }
+    }
+    else /*likely ~50% ?!*/ // (r > deltai)
+    {
+    }
+
+    //
+    // Step 3:
+    // Find the significand with the smaller divisor
+    //
+
+    q *= 10;
+
+    // 0 <= r <= 100
+
+    const uint32_t dist = r - (delta / 2) + (SmallDivisor / 2);
+
+    const uint32_t dist_q = dist / 10;
+    q += dist_q;
+
+    if /*likely*/ (dist == dist_q * 10)
+    {
+        // NB: SmallDivisor / 2 is odd here (in contrast to ToDecimal64).
+        const bool approx_y_parity = ((dist ^ (SmallDivisor / 2)) & 1) != 0;
+
+        // See ToDecimal64.
+        if /*likely*/ (MulParity(two_fc, pow10, beta_minus_1) != approx_y_parity) // 1 mul
+        {
+            --q;
+        }
+        else if (q % 2 != 0 && IsIntegralMidpoint(two_fc, e2, minus_k))
+        {
+            --q;
+        }
+    }
+
+    return {q, minus_k + Kappa};
+}
+
 //==================================================================================================
 // ToChars
 //==================================================================================================
@@ -1472,6 +1863,7 @@ static inline char* FormatDigits(char* buffer, uint64_t digits, int32_t decimal_
     return buffer;
 }
 
+template <ReaderTies Ties = ReaderTies::to_even>
 static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_zero = false)
 {
     const Double v(value);
@@ -1490,7 +1882,51 @@ static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_
         {
             // != 0
 
-            const auto dec = ToDecimal64(significand, exponent);
+            const auto dec = ToDecimal64<Ties>(significand, exponent);
+            return FormatDigits(buffer, dec.significand, dec.exponent, force_trailing_dot_zero);
+        }
+        else
+        {
+            std::memcpy(buffer, "0.0 ", 4);
+            buffer += force_trailing_dot_zero ? 3 : 1;
+            return buffer;
+        }
+    }
+
+    if (significand == 0)
+    {
+        buffer[0] = '-';
+        buffer += v.SignBit();
+
+        std::memcpy(buffer, "inf ", 4);
+        return buffer + 3;
+    }
+    else
+    {
+        std::memcpy(buffer, "nan ", 4);
+        return buffer + 3;
+    }
+}
+
+static inline char* ToChars(char* buffer, float value, bool force_trailing_dot_zero = false)
+{
+    const Single v(value);
+
+    const uint32_t significand = v.PhysicalSignificand();
+    const uint32_t exponent = v.PhysicalExponent();
+
+    if (exponent != Single::MaxIeeeExponent) // [[likely]]
+    {
+        // Finite
+
+        buffer[0] = '-';
+        buffer += v.SignBit();
+
+        if (exponent != 0 || significand != 0) // [[likely]]
+        {
+            // != 0
+
+            const auto dec = ToDecimal32(significand, exponent);
             return FormatDigits(buffer, dec.significand, dec.exponent, force_trailing_dot_zero);
         }
         else
@@ -1524,3 +1960,19 @@ char* dragonbox::Dtoa(char* buffer, double value)
 {
     return ToChars(buffer, value);
 }
+
+template <ReaderTies Ties>
+char* dragonbox::Dtoa(char* buffer, double value)
+{
+    return ToChars<Ties>(buffer, value);
+}
+
+template char* dragonbox::Dtoa<ReaderTies::to_even>(char* buffer, double value);
+template char* dragonbox::Dtoa<ReaderTies::away_from_zero>(char* buffer, double value);
+template char* dragonbox::Dtoa<ReaderTies::toward_zero>(char* buffer, double value);
+template char* dragonbox::Dtoa<ReaderTies::unknown>(char* buffer, double value);
+
+char* dragonbox::Ftoa(char* buffer, float value)
+{
+    return ToChars(buffer, value);
+}
@@ -28,4 +28,34 @@ constexpr int DtoaMinBufferLength = 64;
 
 char* Dtoa(char* buffer, double value);
 
+// char* output_end = Dtoa<ReaderTies::away_from_zero>(buffer, value);
+//
+// Same as above, but the output is optimal for readers which break ties using the given rule,
+// i.e. the output string rounds back to the input number when read in using the given rule, and
+// is as short as possible (and as close to the input number as possible) under this constraint.
+//
+// Dtoa<ReaderTies::to_even> is equivalent to Dtoa.
+// Dtoa<ReaderTies::unknown> produces output which rounds back to the input number regardless of
+// how the reader breaks ties (like Grisu2, but always as short as possible).
+
+enum class ReaderTies {
+    to_even,        // Round-half-to-even
+    away_from_zero, // Round-half-away-from-zero
+    toward_zero,    // Round-half-toward-zero
+    unknown,        // Round-half-to-whatever
+};
+
+template <ReaderTies Ties>
+char* Dtoa(char* buffer, double value);
+
+// char* output_end = Ftoa(buffer, value);
+//
+// Same as Dtoa, but for single-precision numbers.
+//
+// The buffer must be large enough, i.e. >= FtoaMinBufferLength.
+
+constexpr int FtoaMinBufferLength = 64;
+
+char* Ftoa(char* buffer, float value);
+
 } // namespace dragonbox
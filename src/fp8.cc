@@ -0,0 +1,256 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "fp8.h"
+#include "strtod_small.h"
+
+#include <cstdint>
+#include <cstring>
+
+//==================================================================================================
+//
+//==================================================================================================
+
+namespace {
+struct E4M3
+{
+    using bits_type = uint8_t;
+
+    static constexpr int32_t   SignificandSize = 4; // = p   (includes the hidden bit)
+    static constexpr int32_t   ExponentBias    = 7 + (SignificandSize - 1);
+    static constexpr bits_type SignMask        = 0x80;
+    static constexpr bits_type MaxFinite       = 0x7E; // = 448
+    static constexpr bits_type Overflow        = 0x7F; // = NaN
+    static constexpr bits_type NaN             = 0x7F;
+};
+
+struct E5M2
+{
+    using bits_type = uint8_t;
+
+    static constexpr int32_t   SignificandSize = 3; // = p   (includes the hidden bit)
+    static constexpr int32_t   ExponentBias    = 15 + (SignificandSize - 1);
+    static constexpr bits_type SignMask        = 0x80;
+    static constexpr bits_type MaxFinite       = 0x7B; // = 57344
+    static constexpr bits_type Overflow        = 0x7C; // = +Infinity
+    static constexpr bits_type NaN             = 0x7E;
+};
+} // namespace
+
+//==================================================================================================
+// ToChars
+//==================================================================================================
+
+namespace {
+struct ShortestString
+{
+    char chars[15];
+    uint8_t length;
+};
+}
+
+// The shortest representations, generated by scripts/gen_fp8_tables.py using exact rational
+// arithmetic. The output format is the same as that of FormatDigits in schubfach_16.cc.
+// For each number, this is the shortest decimal number which rounds back to the input, and the
+// one closest to the input if there are several such numbers.
+
+static constexpr ShortestString E4M3Strings[256] = {
+        {"0", 1},         {"0.002", 5},     {"0.004", 5},     {"0.006", 5}, // 0x00
+        {"0.008", 5},     {"0.01", 4},      {"0.012", 5},     {"0.014", 5}, // 0x04
+        {"0.016", 5},     {"0.018", 5},     {"0.02", 4},      {"0.021", 5}, // 0x08
+        {"0.023", 5},     {"0.025", 5},     {"0.027", 5},     {"0.03", 4}, // 0x0C
+        {"0.031", 5},     {"0.035", 5},     {"0.04", 4},      {"0.043", 5}, // 0x10
+        {"0.047", 5},     {"0.05", 4},      {"0.055", 5},     {"0.06", 4}, // 0x14
+        {"0.062", 5},     {"0.07", 4},      {"0.08", 4},      {"0.086", 5}, // 0x18
+        {"0.09", 4},      {"0.1", 3},       {"0.11", 4},      {"0.12", 4}, // 0x1C
+        {"0.13", 4},      {"0.14", 4},      {"0.16", 4},      {"0.17", 4}, // 0x20
+        {"0.19", 4},      {"0.2", 3},       {"0.22", 4},      {"0.23", 4}, // 0x24
+        {"0.25", 4},      {"0.28", 4},      {"0.3", 3},       {"0.34", 4}, // 0x28
+        {"0.38", 4},      {"0.4", 3},       {"0.44", 4},      {"0.47", 4}, // 0x2C
+        {"0.5", 3},       {"0.56", 4},      {"0.6", 3},       {"0.7", 3}, // 0x30
+        {"0.75", 4},      {"0.8", 3},       {"0.9", 3},       {"0.94", 4}, // 0x34
+        {"1", 1},         {"1.1", 3},       {"1.2", 3},       {"1.4", 3}, // 0x38
+        {"1.5", 3},       {"1.6", 3},       {"1.8", 3},       {"1.9", 3}, // 0x3C
+        {"2", 1},         {"2.2", 3},       {"2.5", 3},       {"2.8", 3}, // 0x40
+        {"3", 1},         {"3.2", 3},       {"3.5", 3},       {"3.8", 3}, // 0x44
+        {"4", 1},         {"4.5", 3},       {"5", 1},         {"5.5", 3}, // 0x48
+        {"6", 1},         {"6.5", 3},       {"7", 1},         {"7.5", 3}, // 0x4C
+        {"8", 1},         {"9", 1},         {"10", 2},        {"11", 2}, // 0x50
+        {"12", 2},        {"13", 2},        {"14", 2},        {"15", 2}, // 0x54
+        {"16", 2},        {"18", 2},        {"20", 2},        {"22", 2}, // 0x58
+        {"24", 2},        {"26", 2},        {"28", 2},        {"30", 2}, // 0x5C
+        {"32", 2},        {"36", 2},        {"40", 2},        {"44", 2}, // 0x60
+        {"50", 2},        {"52", 2},        {"56", 2},        {"60", 2}, // 0x64
+        {"64", 2},        {"70", 2},        {"80", 2},        {"90", 2}, // 0x68
+        {"100", 3},       {"104", 3},       {"110", 3},       {"120", 3}, // 0x6C
+        {"130", 3},       {"140", 3},       {"160", 3},       {"180", 3}, // 0x70
+        {"200", 3},       {"210", 3},       {"220", 3},       {"240", 3}, // 0x74
+        {"260", 3},       {"300", 3},       {"320", 3},       {"350", 3}, // 0x78
+        {"400", 3},       {"420", 3},       {"450", 3},       {"nan", 3}, // 0x7C
+        {"-0", 2},        {"-0.002", 6},    {"-0.004", 6},    {"-0.006", 6}, // 0x80
+        {"-0.008", 6},    {"-0.01", 5},     {"-0.012", 6},    {"-0.014", 6}, // 0x84
+        {"-0.016", 6},    {"-0.018", 6},    {"-0.02", 5},     {"-0.021", 6}, // 0x88
+        {"-0.023", 6},    {"-0.025", 6},    {"-0.027", 6},    {"-0.03", 5}, // 0x8C
+        {"-0.031", 6},    {"-0.035", 6},    {"-0.04", 5},     {"-0.043", 6}, // 0x90
+        {"-0.047", 6},    {"-0.05", 5},     {"-0.055", 6},    {"-0.06", 5}, // 0x94
+        {"-0.062", 6},    {"-0.07", 5},     {"-0.08", 5},     {"-0.086", 6}, // 0x98
+        {"-0.09", 5},     {"-0.1", 4},      {"-0.11", 5},     {"-0.12", 5}, // 0x9C
+        {"-0.13", 5},     {"-0.14", 5},     {"-0.16", 5},     {"-0.17", 5}, // 0xA0
+        {"-0.19", 5},     {"-0.2", 4},      {"-0.22", 5},     {"-0.23", 5}, // 0xA4
+        {"-0.25", 5},     {"-0.28", 5},     {"-0.3", 4},      {"-0.34", 5}, // 0xA8
+        {"-0.38", 5},     {"-0.4", 4},      {"-0.44", 5},     {"-0.47", 5}, // 0xAC
+        {"-0.5", 4},      {"-0.56", 5},     {"-0.6", 4},      {"-0.7", 4}, // 0xB0
+        {"-0.75", 5},     {"-0.8", 4},      {"-0.9", 4},      {"-0.94", 5}, // 0xB4
+        {"-1", 2},        {"-1.1", 4},      {"-1.2", 4},      {"-1.4", 4}, // 0xB8
+        {"-1.5", 4},      {"-1.6", 4},      {"-1.8", 4},      {"-1.9", 4}, // 0xBC
+        {"-2", 2},        {"-2.2", 4},      {"-2.5", 4},      {"-2.8", 4}, // 0xC0
+        {"-3", 2},        {"-3.2", 4},      {"-3.5", 4},      {"-3.8", 4}, // 0xC4
+        {"-4", 2},        {"-4.5", 4},      {"-5", 2},        {"-5.5", 4}, // 0xC8
+        {"-6", 2},        {"-6.5", 4},      {"-7", 2},        {"-7.5", 4}, // 0xCC
+        {"-8", 2},        {"-9", 2},        {"-10", 3},       {"-11", 3}, // 0xD0
+        {"-12", 3},       {"-13", 3},       {"-14", 3},       {"-15", 3}, // 0xD4
+        {"-16", 3},       {"-18", 3},       {"-20", 3},       {"-22", 3}, // 0xD8
+        {"-24", 3},       {"-26", 3},       {"-28", 3},       {"-30", 3}, // 0xDC
+        {"-32", 3},       {"-36", 3},       {"-40", 3},       {"-44", 3}, // 0xE0
+        {"-50", 3},       {"-52", 3},       {"-56", 3},       {"-60", 3}, // 0xE4
+        {"-64", 3},       {"-70", 3},       {"-80", 3},       {"-90", 3}, // 0xE8
+        {"-100", 4},      {"-104", 4},      {"-110", 4},      {"-120", 4}, // 0xEC
+        {"-130", 4},      {"-140", 4},      {"-160", 4},      {"-180", 4}, // 0xF0
+        {"-200", 4},      {"-210", 4},      {"-220", 4},      {"-240", 4}, // 0xF4
+        {"-260", 4},      {"-300", 4},      {"-320", 4},      {"-350", 4}, // 0xF8
+        {"-400", 4},      {"-420", 4},      {"-450", 4},      {"nan", 3}, // 0xFC
+};
+
+static constexpr ShortestString E5M2Strings[256] = {
+        {"0", 1},         {"0.00002", 7},   {"0.00003", 7},   {"0.00005", 7}, // 0x00
+        {"0.00006", 7},   {"0.00008", 7},   {"0.00009", 7},   {"0.0001", 6}, // 0x04
+        {"0.00012", 7},   {"0.00015", 7},   {"0.00018", 7},   {"0.0002", 6}, // 0x08
+        {"0.00024", 7},   {"0.0003", 6},    {"0.00037", 7},   {"0.0004", 6}, // 0x0C
+        {"0.0005", 6},    {"0.0006", 6},    {"0.0007", 6},    {"0.0009", 6}, // 0x10
+        {"0.001", 5},     {"0.0012", 6},    {"0.0015", 6},    {"0.0017", 6}, // 0x14
+        {"0.002", 5},     {"0.0024", 6},    {"0.003", 5},     {"0.0034", 6}, // 0x18
+        {"0.004", 5},     {"0.005", 5},     {"0.006", 5},     {"0.007", 5}, // 0x1C
+        {"0.008", 5},     {"0.01", 4},      {"0.012", 5},     {"0.014", 5}, // 0x20
+        {"0.016", 5},     {"0.02", 4},      {"0.023", 5},     {"0.027", 5}, // 0x24
+        {"0.03", 4},      {"0.04", 4},      {"0.05", 4},      {"0.055", 5}, // 0x28
+        {"0.06", 4},      {"0.08", 4},      {"0.09", 4},      {"0.11", 4}, // 0x2C
+        {"0.12", 4},      {"0.16", 4},      {"0.2", 3},       {"0.22", 4}, // 0x30
+        {"0.25", 4},      {"0.3", 3},       {"0.4", 3},       {"0.44", 4}, // 0x34
+        {"0.5", 3},       {"0.6", 3},       {"0.8", 3},       {"0.9", 3}, // 0x38
+        {"1", 1},         {"1.2", 3},       {"1.5", 3},       {"1.8", 3}, // 0x3C
+        {"2", 1},         {"2.5", 3},       {"3", 1},         {"3.5", 3}, // 0x40
+        {"4", 1},         {"5", 1},         {"6", 1},         {"7", 1}, // 0x44
+        {"8", 1},         {"10", 2},        {"12", 2},        {"14", 2}, // 0x48
+        {"16", 2},        {"20", 2},        {"24", 2},        {"28", 2}, // 0x4C
+        {"30", 2},        {"40", 2},        {"50", 2},        {"56", 2}, // 0x50
+        {"60", 2},        {"80", 2},        {"100", 3},       {"110", 3}, // 0x54
+        {"130", 3},       {"160", 3},       {"200", 3},       {"220", 3}, // 0x58
+        {"260", 3},       {"300", 3},       {"400", 3},       {"450", 3}, // 0x5C
+        {"500", 3},       {"600", 3},       {"800", 3},       {"900", 3}, // 0x60
+        {"1000", 4},      {"1300", 4},      {"1500", 4},      {"1800", 4}, // 0x64
+        {"2000", 4},      {"2600", 4},      {"3000", 4},      {"3600", 4}, // 0x68
+        {"4000", 4},      {"5000", 4},      {"6000", 4},      {"7000", 4}, // 0x6C
+        {"8000", 4},      {"10000", 5},     {"12000", 5},     {"14000", 5}, // 0x70
+        {"16000", 5},     {"20000", 5},     {"25000", 5},     {"30000", 5}, // 0x74
+        {"33000", 5},     {"40000", 5},     {"50000", 5},     {"60000", 5}, // 0x78
+        {"inf", 3},       {"nan", 3},       {"nan", 3},       {"nan", 3}, // 0x7C
+        {"-0", 2},        {"-0.00002", 8},  {"-0.00003", 8},  {"-0.00005", 8}, // 0x80
+        {"-0.00006", 8},  {"-0.00008", 8},  {"-0.00009", 8},  {"-0.0001", 7}, // 0x84
+        {"-0.00012", 8},  {"-0.00015", 8},  {"-0.00018", 8},  {"-0.0002", 7}, // 0x88
+        {"-0.00024", 8},  {"-0.0003", 7},   {"-0.00037", 8},  {"-0.0004", 7}, // 0x8C
+        {"-0.0005", 7},   {"-0.0006", 7},   {"-0.0007", 7},   {"-0.0009", 7}, // 0x90
+        {"-0.001", 6},    {"-0.0012", 7},   {"-0.0015", 7},   {"-0.0017", 7}, // 0x94
+        {"-0.002", 6},    {"-0.0024", 7},   {"-0.003", 6},    {"-0.0034", 7}, // 0x98
+        {"-0.004", 6},    {"-0.005", 6},    {"-0.006", 6},    {"-0.007", 6}, // 0x9C
+        {"-0.008", 6},    {"-0.01", 5},     {"-0.012", 6},    {"-0.014", 6}, // 0xA0
+        {"-0.016", 6},    {"-0.02", 5},     {"-0.023", 6},    {"-0.027", 6}, // 0xA4
+        {"-0.03", 5},     {"-0.04", 5},     {"-0.05", 5},     {"-0.055", 6}, // 0xA8
+        {"-0.06", 5},     {"-0.08", 5},     {"-0.09", 5},     {"-0.11", 5}, // 0xAC
+        {"-0.12", 5},     {"-0.16", 5},     {"-0.2", 4},      {"-0.22", 5}, // 0xB0
+        {"-0.25", 5},     {"-0.3", 4},      {"-0.4", 4},      {"-0.44", 5}, // 0xB4
+        {"-0.5", 4},      {"-0.6", 4},      {"-0.8", 4},      {"-0.9", 4}, // 0xB8
+        {"-1", 2},        {"-1.2", 4},      {"-1.5", 4},      {"-1.8", 4}, // 0xBC
+        {"-2", 2},        {"-2.5", 4},      {"-3", 2},        {"-3.5", 4}, // 0xC0
+        {"-4", 2},        {"-5", 2},        {"-6", 2},        {"-7", 2}, // 0xC4
+        {"-8", 2},        {"-10", 3},       {"-12", 3},       {"-14", 3}, // 0xC8
+        {"-16", 3},       {"-20", 3},       {"-24", 3},       {"-28", 3}, // 0xCC
+        {"-30", 3},       {"-40", 3},       {"-50", 3},       {"-56", 3}, // 0xD0
+        {"-60", 3},       {"-80", 3},       {"-100", 4},      {"-110", 4}, // 0xD4
+        {"-130", 4},      {"-160", 4},      {"-200", 4},      {"-220", 4}, // 0xD8
+        {"-260", 4},      {"-300", 4},      {"-400", 4},      {"-450", 4}, // 0xDC
+        {"-500", 4},      {"-600", 4},      {"-800", 4},      {"-900", 4}, // 0xE0
+        {"-1000", 5},     {"-1300", 5},     {"-1500", 5},     {"-1800", 5}, // 0xE4
+        {"-2000", 5},     {"-2600", 5},     {"-3000", 5},     {"-3600", 5}, // 0xE8
+        {"-4000", 5},     {"-5000", 5},     {"-6000", 5},     {"-7000", 5}, // 0xEC
+        {"-8000", 5},     {"-10000", 6},    {"-12000", 6},    {"-14000", 6}, // 0xF0
+        {"-16000", 6},    {"-20000", 6},    {"-25000", 6},    {"-30000", 6}, // 0xF4
+        {"-33000", 6},    {"-40000", 6},    {"-50000", 6},    {"-60000", 6}, // 0xF8
+        {"-inf", 4},      {"nan", 3},       {"nan", 3},       {"nan", 3}, // 0xFC
+};
+
+static inline char* ToChars(char* buffer, const ShortestString& str)
+{
+    static_assert(sizeof(ShortestString) == 16, "internal error");
+    static_assert(fp8::Fp8toaMinBufferLength >= 16, "internal error");
+
+    std::memcpy(buffer, str.chars, 16);
+    return buffer + str.length;
+}
+
+static inline char* ToCharsBatch(char* buffer, const ShortestString* table, const uint8_t* values, size_t count, char delimiter)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i != 0)
+            *buffer++ = delimiter;
+        buffer = ToChars(buffer, table[values[i]]);
+    }
+
+    return buffer;
+}
+
+//==================================================================================================
+//
+//==================================================================================================
+
+char* fp8::E4M3toa(char* buffer, uint8_t value)
+{
+    return ToChars(buffer, E4M3Strings[value]);
+}
+
+char* fp8::E5M2toa(char* buffer, uint8_t value)
+{
+    return ToChars(buffer, E5M2Strings[value]);
+}
+
+char* fp8::E4M3toaBatch(char* buffer, const uint8_t* values, size_t count, char delimiter)
+{
+    return ToCharsBatch(buffer, E4M3Strings, values, count, delimiter);
+}
+
+char* fp8::E5M2toaBatch(char* buffer, const uint8_t* values, size_t count, char delimiter)
+{
+    return ToCharsBatch(buffer, E5M2Strings, values, count, delimiter);
+}
+
+ryu::StrtodResult fp8::StrtoE4M3(const char* next, const char* last, uint8_t& value, bool saturate)
+{
+    return strtod_small::Strtod<E4M3>(next, last, value, saturate);
+}
+
+ryu::StrtodResult fp8::StrtoE5M2(const char* next, const char* last, uint8_t& value, bool saturate)
+{
+    return strtod_small::Strtod<E5M2>(next, last, value, saturate);
+}
+
+size_t fp8::StrtoE4M3Batch(const char* first, const char* last, char delimiter, uint8_t* values, size_t max_values, bool saturate)
+{
+    return strtod_small::StrtodBatch<E4M3>(first, last, delimiter, values, max_values, saturate);
+}
+
+size_t fp8::StrtoE5M2Batch(const char* first, const char* last, char delimiter, uint8_t* values, size_t max_values, bool saturate)
+{
+    return strtod_small::StrtodBatch<E5M2>(first, last, delimiter, values, max_values, saturate);
+}
@@ -0,0 +1,72 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ryu_64.h" // StrtodResult, TokenSpan
+
+namespace fp8 {
+
+// The 8-bit floating-point formats E4M3 and E5M2 (OCP 8-bit Floating Point Specification).
+//
+// E4M3: 4 exponent bits (bias 7), 3 significand bits. No infinities; S.1111.111 is NaN.
+//       The largest finite number is 448.
+// E5M2: 5 exponent bits (bias 15), 2 significand bits. Same layout as IEEE binary16 with the
+//       lower 8 significand bits removed. The largest finite number is 57344.
+
+// char* output_end = E4M3toa(buffer, value);
+// char* output_end = E5M2toa(buffer, value);
+//
+// Converts the given 8-bit floating-point number into its shortest decimal representation, which
+// rounds back to the input number when read in (using round-to-nearest-even).
+// The output format is the same as that of schubfach::Htoa. The conversion is a table lookup.
+//
+// The buffer must be large enough, i.e. >= Fp8toaMinBufferLength.
+// The output is _not_ null-terminted.
+//
+// Note:
+// This function may temporarily write up to Fp8toaMinBufferLength characters into the buffer.
+
+constexpr int Fp8toaMinBufferLength = 16;
+
+char* E4M3toa(char* buffer, uint8_t value);
+char* E5M2toa(char* buffer, uint8_t value);
+
+// char* output_end = E4M3toaBatch(buffer, values, count, delimiter);
+// char* output_end = E5M2toaBatch(buffer, values, count, delimiter);
+//
+// Converts count numbers as above and separates them by the given delimiter.
+// The buffer must be large enough, i.e. >= count * Fp8toaMinBufferLength.
+
+char* E4M3toaBatch(char* buffer, const uint8_t* values, size_t count, char delimiter);
+char* E5M2toaBatch(char* buffer, const uint8_t* values, size_t count, char delimiter);
+
+// StrtodResult conversion_result = StrtoE4M3(first, last, value, saturate);
+// StrtodResult conversion_result = StrtoE5M2(first, last, value, saturate);
+//
+// Converts the given decimal floating-point number into the nearest 8-bit floating-point number
+// (ties to even). The function accepts the same inputs as ryu::Strtod.
+//
+// Numbers which are too large for the target format are converted into NaN (E4M3) or infinity
+// (E5M2). If saturate is true, such numbers, including infinities, are converted into the largest
+// finite number (with the sign of the input) instead. NaNs are always converted into NaN.
+
+ryu::StrtodResult StrtoE4M3(const char* next, const char* last, uint8_t& value, bool saturate = false);
+ryu::StrtodResult StrtoE5M2(const char* next, const char* last, uint8_t& value, bool saturate = false);
+
+// size_t count = StrtoE4M3Batch(first, last, delimiter, values, max_values, saturate);
+// size_t count = StrtoE5M2Batch(first, last, delimiter, values, max_values, saturate);
+//
+// Splits [first, last) into tokens, using ryu::ForEachToken, and converts each token as above.
+// Returns the number of tokens processed, which is at most max_values. Tokens which are not valid
+// numbers are converted into NaN.
+
+size_t StrtoE4M3Batch(const char* first, const char* last, char delimiter, uint8_t* values, size_t max_values, bool saturate = false);
+size_t StrtoE5M2Batch(const char* first, const char* last, char delimiter, uint8_t* values, size_t max_values, bool saturate = false);
+
+} // namespace fp8
@@ -112,6 +112,83 @@ struct Double
         return ReinterpretBits<value_type>(bits & ~SignMask);
     }
 };
+
+struct Single
+{
+    static_assert(std::numeric_limits<float>::is_iec559
+               && std::numeric_limits<float>::digits == 24
+               && std::numeric_limits<float>::max_exponent == 128,
+        "IEEE-754 single-precision implementation required");
+
+    using value_type = float;
+    using bits_type = uint32_t;
+
+//  static constexpr int32_t   MaxDigits10     = std::numeric_limits<value_type>::max_digits10;
+    static constexpr int32_t   SignificandSize = std::numeric_limits<value_type>::digits; // = p   (includes the hidden bit)
+    static constexpr int32_t   ExponentBias    = std::numeric_limits<value_type>::max_exponent - 1 + (SignificandSize - 1);
+//  static constexpr int32_t   MaxExponent     = std::numeric_limits<value_type>::max_exponent - 1 - (SignificandSize - 1);
+    static constexpr int32_t   MinExponent     = std::numeric_limits<value_type>::min_exponent - 1 - (SignificandSize - 1);
+    static constexpr bits_type HiddenBit       = bits_type{1} << (SignificandSize - 1);   // = 2^(p-1)
+    static constexpr bits_type SignificandMask = HiddenBit - 1;                           // = 2^(p-1) - 1
+    static constexpr bits_type ExponentMask    = (bits_type{2 * std::numeric_limits<value_type>::max_exponent - 1}) << (SignificandSize - 1);
+    static constexpr bits_type SignMask        = ~(~bits_type{0} >> 1);
+
+    bits_type bits;
+
+    explicit Single(bits_type bits_) : bits(bits_) {}
+    explicit Single(value_type value) : bits(ReinterpretBits<bits_type>(value)) {}
+
+    bits_type PhysicalSignificand() const {
+        return bits & SignificandMask;
+    }
+
+    bits_type PhysicalExponent() const {
+        return (bits & ExponentMask) >> (SignificandSize - 1);
+    }
+
+    struct Decomposed {
+        bits_type f;
+        int e;
+    };
+
+    // Returns f, e such that value = f * 2^e
+    Decomposed Decompose() const {
+        const auto F = PhysicalSignificand();
+        const auto E = PhysicalExponent();
+        if (E == 0)
+            return {F, 1 - ExponentBias};
+        else
+            return {F | HiddenBit, static_cast<int>(E) - ExponentBias};
+    }
+
+    bool IsFinite() const {
+        return (bits & ExponentMask) != ExponentMask;
+    }
+
+    bool IsInf() const {
+        return (bits & ExponentMask) == ExponentMask && (bits & SignificandMask) == 0;
+    }
+
+    bool IsNaN() const {
+        return (bits & ExponentMask) == ExponentMask && (bits & SignificandMask) != 0;
+    }
+
+    bool IsZero() const {
+        return (bits & ~SignMask) == 0;
+    }
+
+    bool SignBit() const {
+        return (bits & SignMask) != 0;
+    }
+
+    value_type Value() const {
+        return ReinterpretBits<value_type>(bits);
+    }
+
+    value_type AbsValue() const {
+        return ReinterpretBits<value_type>(bits & ~SignMask);
+    }
+};
 } // namespace
 
 //==================================================================================================
@@ -317,7 +394,7 @@ static inline int CountLeadingZeros64(uint64_t x)
 //           -11        (normalize the DiyFp)
 //         = 960
 //
-// For IEEE single-precision the range is [-180, 96].
+// For IEEE single-precision the range is [-212, 64].
 //
 // One does not need to store a cached power for each k in this range. For each
 // such k it suffices to find a cached power such that the exponent of the
@@ -353,7 +430,11 @@ static constexpr int kCachedPowersDecExpStep =    8;
 //
 //      kAlpha <= e_c + e + q <= kGamma.
 //
-static inline CachedPower GetCachedPowerForBinaryExponent(int e)
+template <typename Fp>
+static inline CachedPower GetCachedPowerForBinaryExponent(int e);
+
+template <>
+inline CachedPower GetCachedPowerForBinaryExponent<Double>(int e)
 {
     static constexpr uint64_t kSignificands[] = {
         0xAB70FE17C79AC6CA, // e = -1060, k = -300
@@ -457,6 +538,50 @@ static inline CachedPower GetCachedPowerForBinaryExponent(int e)
     return cached;
 }
 
+// Same as above, but only for the binary exponents which are required for single-precision
+// numbers, i.e. e in [-212, 64]. The table is a subset of the table above.
+static constexpr int kSingleCachedPowersSize       =  12;
+static constexpr int kSingleCachedPowersMinDecExp  = -36;
+static constexpr int kSingleCachedPowersMaxDecExp  =  52;
+
+template <>
+inline CachedPower GetCachedPowerForBinaryExponent<Single>(int e)
+{
+    static constexpr uint64_t kSignificands[] = {
+        0xAA242499697392D3, // e =  -183, k =  -36
+        0xFD87B5F28300CA0E, // e =  -157, k =  -28
+        0xBCE5086492111AEB, // e =  -130, k =  -20
+        0x8CBCCC096F5088CC, // e =  -103, k =  -12
+        0xD1B71758E219652C, // e =   -77, k =   -4
+        0x9C40000000000000, // e =   -50, k =    4
+        0xE8D4A51000000000, // e =   -24, k =   12
+        0xAD78EBC5AC620000, // e =     3, k =   20
+        0x813F3978F8940984, // e =    30, k =   28
+        0xC097CE7BC90715B3, // e =    56, k =   36
+        0x8F7E32CE7BEA5C70, // e =    83, k =   44
+        0xD5D238A4ABE98068, // e =   109, k =   52
+    };
+
+    GRISU_ASSERT(e >= -212);
+    GRISU_ASSERT(e <=   64);
+
+    const int k = CeilLog10Pow2(kAlpha - e - 1);
+    GRISU_ASSERT(k >= kSingleCachedPowersMinDecExp - (kCachedPowersDecExpStep - 1));
+    GRISU_ASSERT(k <= kSingleCachedPowersMaxDecExp);
+
+    const unsigned index = static_cast<unsigned>(k - (kSingleCachedPowersMinDecExp - (kCachedPowersDecExpStep - 1))) / kCachedPowersDecExpStep;
+    GRISU_ASSERT(index < kSingleCachedPowersSize);
+
+    const int k_cached = kSingleCachedPowersMinDecExp + static_cast<int>(index) * kCachedPowersDecExpStep;
+    const int e_cached = FloorLog2Pow10(k_cached) + 1 - 64;
+
+    const CachedPower cached = {kSignificands[index], e_cached, k_cached};
+    GRISU_ASSERT(kAlpha <= cached.e + e + 64);
+    GRISU_ASSERT(kGamma >= cached.e + e + 64);
+
+    return cached;
+}
+
 namespace {
 struct FloatingDecimal64 {
     uint64_t digits;
@@ -464,9 +589,10 @@ struct FloatingDecimal64 {
 };
 }
 
-static inline bool Grisu3(FloatingDecimal64& dec, double value)
+template <typename Fp>
+static inline bool Grisu3(FloatingDecimal64& dec, typename Fp::value_type value)
 {
-    static_assert(DiyFp::SignificandSize >= std::numeric_limits<double>::digits + 3,
+    static_assert(DiyFp::SignificandSize >= Fp::SignificandSize + 3,
         "Grisu3 requires q >= p + 3");
     static_assert(DiyFp::SignificandSize == 64,
         "This implementation requires q = 64");
@@ -492,10 +618,10 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
     //      -----------------+------+------+-------------+-------------+---  (B)
     //                       v-     m-     v             m+            v+
 
-    GRISU_ASSERT(Double(value).IsFinite());
+    GRISU_ASSERT(Fp(value).IsFinite());
     GRISU_ASSERT(value > 0);
 
-    const auto ieee_value = Double(value);
+    const auto ieee_value = Fp(value);
     const auto ieee_significand = ieee_value.PhysicalSignificand();
     const auto ieee_exponent    = ieee_value.PhysicalExponent();
 
@@ -508,11 +634,11 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
     {
         const bool lower_boundary_is_closer = (ieee_significand == 0 && ieee_exponent > 1);
 
-        const auto f2 = ieee_significand | Double::HiddenBit;
-        const auto e2 = static_cast<int>(ieee_exponent) - Double::ExponentBias;
+        const auto f2 = ieee_significand | Fp::HiddenBit;
+        const auto e2 = static_cast<int>(ieee_exponent) - Fp::ExponentBias;
 
 #if GRISU_SMALL_INT_OPTIMIZATION()
-        if (0 <= -e2 && -e2 < 53)
+        if (0 <= -e2 && -e2 < Fp::SignificandSize)
         {
             const uint64_t d2 = f2 >> -e2;
             if (d2 << -e2 == f2)
@@ -528,7 +654,7 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
         const auto fv = 4 * f2;
         const auto fp = 4 * f2 + 2;
 
-        const auto shift = DiyFp::SignificandSize - Double::SignificandSize - 2;
+        const auto shift = DiyFp::SignificandSize - Fp::SignificandSize - 2;
 
         shared_exponent = e2 - 2 - shift;
         m_minus = uint64_t{fm} << shift;
@@ -538,7 +664,7 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
     else
     {
         const auto f2 = ieee_significand;
-        const auto e2 = 1 - Double::ExponentBias;
+        const auto e2 = 1 - Fp::ExponentBias;
 
         const auto fm = 4 * f2 - 2;
         const auto fv = 4 * f2;
@@ -568,7 +694,7 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
     // First scale v (and m- and m+) such that the exponent is in the range
     // [alpha, gamma].
 
-    const auto cached = GetCachedPowerForBinaryExponent(shared_exponent);
+    const auto cached = GetCachedPowerForBinaryExponent<Fp>(shared_exponent);
 
     const uint64_t w_minus = MultiplyHighRoundUp(m_minus, cached.f); // XXX: round down?
     const uint64_t w       = MultiplyHighRoundUp(v,       cached.f); // XXX: compute from w_minus/w_plus?
@@ -914,18 +1040,19 @@ static inline bool Grisu3(FloatingDecimal64& dec, double value)
     return true;
 }
 
-static inline FloatingDecimal64 ToDecimal64(double value)
+template <typename Fp>
+static inline FloatingDecimal64 ToDecimal64(typename Fp::value_type value)
 {
     FloatingDecimal64 dec;
 
-    const bool ok = Grisu3(dec, value);
+    const bool ok = Grisu3<Fp>(dec, value);
     if (!ok)
     {
-        const auto v = Double(value).Decompose();
+        const auto v = Fp(value).Decompose();
 
         const bool is_even = (v.f % 2 == 0);
         const bool accept_bounds = is_even;
-        const bool lower_boundary_is_closer = (v.f == Double::HiddenBit && v.e > Double::MinExponent);
+        const bool lower_boundary_is_closer = (v.f == Fp::HiddenBit && v.e > Fp::MinExponent);
 
         dragon4::Dragon4(dec.digits, dec.exponent, v.f, v.e, accept_bounds, lower_boundary_is_closer);
     }
@@ -1185,9 +1312,10 @@ static inline char* FormatDigits(char* buffer, uint64_t digits, int32_t decimal_
     return buffer;
 }
 
-static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_zero = false)
+template <typename Fp>
+static inline char* ToChars(char* buffer, typename Fp::value_type value, bool force_trailing_dot_zero = false)
 {
-    const Double v(value);
+    const Fp v(value);
 
     if (!v.IsFinite())
     {
@@ -1217,7 +1345,7 @@ static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_
         return buffer;
     }
 
-    const auto dec = ToDecimal64(value);
+    const auto dec = ToDecimal64<Fp>(value);
     return FormatDigits(buffer, dec.digits, dec.exponent, force_trailing_dot_zero);
 }
 
@@ -1227,5 +1355,10 @@ static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_
 
 char* grisu3::Dtoa(char* buffer, double value)
 {
-    return ToChars(buffer, value);
+    return ToChars<Double>(buffer, value);
+}
+
+char* grisu3::Ftoa(char* buffer, float value)
+{
+    return ToChars<Single>(buffer, value);
 }
@@ -23,4 +23,14 @@ constexpr int DtoaMinBufferLength = 64;
 
 char* Dtoa(char* buffer, double value);
 
+// char* output_end = Ftoa(buffer, value);
+//
+// Same as Dtoa, but for single-precision numbers.
+//
+// The buffer must be large enough, i.e. >= FtoaMinBufferLength.
+
+constexpr int FtoaMinBufferLength = 64;
+
+char* Ftoa(char* buffer, float value);
+
 } // namespace grisu3
@@ -1488,7 +1488,32 @@ static inline uint32_t SmallPow10(const int32_t e10)
     return Pow10Table[static_cast<uint32_t>(e10)];
 }
 
-static inline float MulRoundDiv(const float value, const int32_t mul_e10, const int32_t div_e10)
+// Returns whether the magnitude i + f/pow10, where 0 <= f < pow10, should be rounded up to i + 1.
+// (The sign is required for the directed rounding modes.)
+static inline bool RoundUp(const uint32_t i, const uint32_t f, const uint32_t pow10, const bool negative, const ryu::DecimalRounding mode)
+{
+    RYU_ASSERT(f < pow10);
+    RYU_ASSERT(pow10 % 2 == 0);
+
+    switch (mode)
+    {
+    case ryu::DecimalRounding::half_away_from_zero:
+        return f >= pow10 / 2;
+    case ryu::DecimalRounding::half_even:
+        return f > pow10 / 2 || (f == pow10 / 2 && i % 2 != 0);
+    case ryu::DecimalRounding::toward_zero:
+        return false;
+    case ryu::DecimalRounding::upward:
+        return !negative && f != 0;
+    case ryu::DecimalRounding::downward:
+        return negative && f != 0;
+    }
+
+    RYU_ASSERT(false);
+    return false;
+}
+
+static inline float MulRoundDiv(const float value, const int32_t mul_e10, const int32_t div_e10, const ryu::DecimalRounding mode = ryu::DecimalRounding::half_away_from_zero)
 {
     const Single v(value);
 
@@ -1512,7 +1537,8 @@ static inline float MulRoundDiv(const float value, const int32_t mul_e10, const
     // Multiply by 10^mul_e10
     exponent += mul_e10;
 
-    // Round x = digits * 10^exponent to the nearest integer.
+    // Round x = digits * 10^exponent to an integer.
+    const bool negative = value < 0;
 
     // We have
     // x = digits * 10^exponent
@@ -1533,8 +1559,8 @@ static inline float MulRoundDiv(const float value, const int32_t mul_e10, const
         const uint32_t i = digits / pow10;
         const uint32_t f = digits % pow10;
 
-        // Round to int (towards +inf)
-        digits      = i + (f >= pow10 / 2);
+        // Round to int
+        digits      = i + (RoundUp(i, f, pow10, negative, mode) ? 1 : 0);
         num_digits  = DecimalLength(digits);
         exponent    = 0;
     }
@@ -1542,19 +1568,18 @@ static inline float MulRoundDiv(const float value, const int32_t mul_e10, const
     {
         // 1/10 <= x < 1
 
-        // x < 1/2 <==> 10x < 5
-        //         <==> 10 (digits / 10^e10) < 5
-        //         <==> digits < 5 * 10^(e10 - 1)
+        // x = 0 + digits / 10^e10,
+        // and, e.g., x < 1/2 <==> digits < 5 * 10^(e10 - 1)
 
-        digits      = (digits >= 5 * SmallPow10(e10 - 1)) ? 1 : 0;
+        digits      = RoundUp(0, digits, SmallPow10(e10), negative, mode) ? 1 : 0;
         num_digits  = 1;
         exponent    = 0;
     }
     else
     {
         // x < 1/10
-        // This definitely rounds to 0.
-        digits      = 0;
+        // This definitely rounds to 0, unless rounding away from zero.
+        digits      = RoundUp(0, 1, 10, negative, mode) ? 1 : 0;
         num_digits  = 1;
         exponent    = 0;
     }
@@ -1593,3 +1618,65 @@ float ryu::Round10(const float value, const int n)
 
     return MulRoundDiv(value, -n, -n);
 }
+
+float ryu::Round10(const float value, const int n, const DecimalRounding mode)
+{
+    if (n < -1000 || n > +1000) // (Not supported yet)
+        return value;
+
+    return MulRoundDiv(value, -n, -n, mode);
+}
+
+float ryu::RoundSignificant(const float value, const int digits, const ryu::DecimalRounding mode)
+{
+    const Single v(value);
+
+    const uint32_t F = v.PhysicalSignificand();
+    const uint32_t E = v.PhysicalExponent();
+
+    if (E == Single::MaxIeeeExponent || (E == 0 && F == 0) || digits < 1)
+    {
+        // +-0, or Infinity, or NaN
+        return value;
+    }
+
+    // Convert to decimal
+    const FloatingDecimal32 dec = ToDecimal32(F, E);
+
+    const int32_t num_digits = DecimalLength(dec.digits);
+    if (num_digits <= digits)
+        return value;
+
+    // Remove the last (num_digits - digits) digits, and round using the given rounding mode.
+    const uint32_t pow10 = SmallPow10(num_digits - digits);
+    const uint32_t i = dec.digits / pow10;
+    const uint32_t f = dec.digits % pow10;
+
+    const uint32_t rounded  = i + (RoundUp(i, f, pow10, value < 0, mode) ? 1 : 0);
+    const int32_t  exponent = dec.exponent + (num_digits - digits);
+
+    // And convert back to binary.
+    // NB: rounded may have digits + 1 digits here (if it is 10^digits).
+    const int32_t rounded_digits = DecimalLength(rounded);
+
+    float flt;
+    if (exponent + rounded_digits > MaxDecimalExponent)
+    {
+        flt = std::numeric_limits<float>::infinity();
+    }
+    else
+    {
+        // (rounded >= 1 and value >= denorm_min, so the result cannot underflow.)
+        flt = ToBinary32(rounded, rounded_digits, exponent);
+    }
+
+    return value < 0 ? -flt : flt;
+}
+
+void ryu::RoundSignificantBatch(const float* values, float* results, size_t count, int digits, ryu::DecimalRounding mode)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = RoundSignificant(values[i], digits, mode);
+    }
+}
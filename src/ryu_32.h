@@ -8,6 +8,10 @@
 
 #define RYU_STRTOD_FALLBACK() 1
 
+#include <cstddef>
+
+#include "ryu_64.h" // DecimalRounding
+
 namespace ryu {
 
 // char* output_end = Ftoa(buffer, value);
@@ -82,4 +86,23 @@ StrtofResult Strtof(const char* first, const char* last, float& value);
 //       Round10(55.0f, 1) == 60.0f
 float Round10(float value, int n);
 
+// Round10(x, n, mode) returns x rounded to a multiple of 10^n, using the given rounding mode.
+//
+// Same as the double-precision version, but using the shortest decimal representation of the
+// single-precision number x (as produced by Ftoa).
+float Round10(float value, int n, DecimalRounding mode);
+
+// RoundSignificant(x, digits, mode) returns x rounded to the given number of significant decimal
+// digits, using the given rounding mode.
+//
+// Same as the double-precision version, but using the shortest decimal representation of the
+// single-precision number x (as produced by Ftoa).
+// E.g.: RoundSignificant(1.005f, 3) == 1.01f
+float RoundSignificant(float value, int digits, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
+// RoundSignificantBatch(values, results, count, digits, mode);
+//
+// Computes results[i] = RoundSignificant(values[i], digits, mode) for all 0 <= i < count.
+void RoundSignificantBatch(const float* values, float* results, size_t count, int digits, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
 } // namespace ryu
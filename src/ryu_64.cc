@@ -21,6 +21,7 @@
 //#undef NDEBUG
 #include <cassert>
 #include <climits>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -33,6 +34,12 @@
 #if _MSC_VER
 #include <intrin.h>
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2() 1
+#include <emmintrin.h>
+#else
+#define HAS_SSE2() 0
+#endif
 
 #ifndef RYU_ASSERT
 #define RYU_ASSERT(X) assert(X)
@@ -1433,6 +1440,34 @@ static inline int32_t DecimalLength(uint64_t v)
     return 1;
 }
 
+static inline uint64_t SmallPow10(int32_t e10)
+{
+    static constexpr uint64_t Pow10Table[] = {
+        1,
+        10,
+        100,
+        1000,
+        10000,
+        100000,
+        1000000,
+        10000000,
+        100000000,
+        1000000000,
+        10000000000,
+        100000000000,
+        1000000000000,
+        10000000000000,
+        100000000000000,
+        1000000000000000,
+        10000000000000000,
+        100000000000000000,
+    };
+
+    RYU_ASSERT(e10 >= 0);
+    RYU_ASSERT(e10 <= 17);
+    return Pow10Table[static_cast<uint32_t>(e10)];
+}
+
 static inline char* FormatDigits(char* buffer, uint64_t digits, int32_t decimal_exponent, bool force_trailing_dot_zero = false)
 {
     static constexpr int32_t MinFixedDecimalPoint = -6;
@@ -1675,7 +1710,16 @@ static inline int32_t ExtractBit(uint64_t x, int32_t n)
     return (x & (uint64_t{1} << n)) != 0;
 }
 
-static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10)
+namespace {
+// Rounding applied to the magnitude of the result. (The sign is handled by the caller.)
+enum class RoundMagnitude {
+    nearest_even,
+    toward_zero,
+    away_from_zero,
+};
+}
+
+static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10, RoundMagnitude rounding = RoundMagnitude::nearest_even)
 {
     static constexpr int32_t MantissaBits = Double::SignificandSize - 1;
     static constexpr int32_t ExponentBias = Double::ExponentBias - (Double::SignificandSize - 1);
@@ -1756,15 +1800,30 @@ static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10)
     // NB:
     // num_digits is unused...
 
-    if (m10 <= (uint64_t{1} << 53) && -22 <= e10 && e10 <= 22)
+    if (rounding == RoundMagnitude::nearest_even)
     {
-        double flt = static_cast<double>(static_cast<int64_t>(m10));
-        if (e10 < 0)
-            flt /= ExactPowersOfTen[static_cast<uint32_t>(-e10)];
-        else
-            flt *= ExactPowersOfTen[static_cast<uint32_t>( e10)];
+        if (m10 <= (uint64_t{1} << 53) && -22 <= e10 && e10 <= 22)
+        {
+            double flt = static_cast<double>(static_cast<int64_t>(m10));
+            if (e10 < 0)
+                flt /= ExactPowersOfTen[static_cast<uint32_t>(-e10)];
+            else
+                flt *= ExactPowersOfTen[static_cast<uint32_t>( e10)];
 
-        return flt;
+            return flt;
+        }
+    }
+    else
+    {
+        // The multiplication above is rounded to nearest. It may only be used for the directed
+        // rounding modes if the result is exact, i.e. if the input is an integer < 2^53.
+        // (If the exact product is >= 2^53, the rounded product is >= 2^53, too.)
+        if (m10 <= (uint64_t{1} << 53) && 0 <= e10 && e10 <= 22)
+        {
+            const double flt = static_cast<double>(static_cast<int64_t>(m10)) * ExactPowersOfTen[static_cast<uint32_t>(e10)];
+            if (flt < 9007199254740992.0) // 2^53
+                return flt;
+        }
     }
 #endif
 #endif
@@ -1872,7 +1931,9 @@ static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10)
     {
         // Overflow:
         // Final IEEE exponent is larger than the maximum representable.
-        return std::numeric_limits<double>::infinity();
+        return rounding == RoundMagnitude::toward_zero
+            ? std::numeric_limits<double>::max()
+            : std::numeric_limits<double>::infinity();
     }
 
     // We need to figure out how much we need to shift m2.
@@ -1889,8 +1950,22 @@ static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10)
         = is_exact && MultipleOfPow2(m2, shift - 1);
     const auto last_removed_bit
         = ExtractBit(m2, shift - 1);
-    const auto round_up
-        = last_removed_bit != 0 && (!trailing_zeros || ExtractBit(m2, shift) != 0);
+
+    bool round_up;
+    switch (rounding)
+    {
+    case RoundMagnitude::nearest_even:
+    default:
+        round_up = last_removed_bit != 0 && (!trailing_zeros || ExtractBit(m2, shift) != 0);
+        break;
+    case RoundMagnitude::toward_zero:
+        round_up = false;
+        break;
+    case RoundMagnitude::away_from_zero:
+        // Round up if any of the removed bits is non-zero.
+        round_up = last_removed_bit != 0 || !trailing_zeros;
+        break;
+    }
 
     uint64_t significand = (m2 >> shift) + round_up;
     RYU_ASSERT(significand <= 2 * Double::HiddenBit); // significand <= 2^p = 2^53
@@ -1917,6 +1992,7 @@ static inline double ToBinary64(uint64_t m10, int32_t m10_digits, int32_t e10)
 
 using ryu::StrtodStatus;
 using ryu::StrtodResult;
+using ryu::RoundingMode;
 
 static inline bool IsDigit(char ch)
 {
@@ -2056,7 +2132,328 @@ static RYU_NEVER_INLINE double ToBinary64Slow(const char* next, const char* last
 }
 #endif
 
-StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
+//
+// Exact comparison of long decimal inputs against a binary floating-point number.
+// Used for the directed rounding modes, where the fallback algorithm above (which always rounds to
+// nearest) might be off by 1 ulp, and for rounding 17-digit decimals to decimal64.
+//
+
+namespace {
+struct DiyInt
+{
+    // The input is truncated to MaxSignificantDigits decimal digits (any remaining non-zero digits
+    // only act as a sticky bit). Note that no double has more than 767 significant digits.
+    static constexpr int32_t MaxSignificantDigits = 800;
+
+    static constexpr int32_t MaxBits = 4096;
+    static constexpr int32_t Capacity = MaxBits / 32;
+
+    uint32_t bigits[Capacity]; // Significand stored in little-endian form.
+    int32_t  size = 0;
+};
+}
+
+// x := A * x + B
+static inline void MulAddU32(DiyInt& x, uint32_t A, uint32_t B = 0)
+{
+    uint32_t carry = B;
+    for (int32_t i = 0; i < x.size; ++i)
+    {
+        const uint64_t p = uint64_t{x.bigits[i]} * A + carry;
+        x.bigits[i]      = static_cast<uint32_t>(p);
+        carry            = static_cast<uint32_t>(p >> 32);
+    }
+
+    if (carry != 0)
+    {
+        RYU_ASSERT(x.size < DiyInt::Capacity);
+        x.bigits[x.size++] = carry;
+    }
+}
+
+// x := x * 2^e2
+static inline void MulPow2(DiyInt& x, int32_t e2)
+{
+    RYU_ASSERT(e2 >= 0);
+
+    if (x.size == 0 || e2 == 0)
+        return;
+
+    const int32_t bigit_shift = e2 / 32;
+    const int32_t bit_shift   = e2 % 32;
+
+    if (bit_shift > 0)
+    {
+        uint32_t carry = 0;
+        for (int32_t i = 0; i < x.size; ++i)
+        {
+            const uint32_t h = x.bigits[i] >> (32 - bit_shift);
+            x.bigits[i]      = x.bigits[i] << bit_shift | carry;
+            carry            = h;
+        }
+
+        if (carry != 0)
+        {
+            RYU_ASSERT(x.size < DiyInt::Capacity);
+            x.bigits[x.size++] = carry;
+        }
+    }
+
+    if (bigit_shift > 0)
+    {
+        RYU_ASSERT(x.size <= DiyInt::Capacity - bigit_shift);
+        std::memmove(x.bigits + bigit_shift, x.bigits, static_cast<size_t>(x.size) * sizeof(uint32_t));
+        std::memset(x.bigits, 0, static_cast<size_t>(bigit_shift) * sizeof(uint32_t));
+        x.size += bigit_shift;
+    }
+}
+
+// x := x * 5^e5
+static inline void MulPow5(DiyInt& x, int32_t e5)
+{
+    RYU_ASSERT(e5 >= 0);
+
+    while (e5 >= 13)
+    {
+        MulAddU32(x, 1220703125u); // 5^13
+        e5 -= 13;
+    }
+
+    uint32_t pow5 = 1;
+    for ( ; e5 > 0; --e5)
+        pow5 *= 5;
+
+    MulAddU32(x, pow5);
+}
+
+// Returns: -1 if x < y, 0 if x == y, +1 if x > y.
+static inline int32_t Compare(const DiyInt& x, const DiyInt& y)
+{
+    if (x.size != y.size)
+        return x.size < y.size ? -1 : +1;
+
+    for (int32_t i = x.size - 1; i >= 0; --i)
+    {
+        if (x.bigits[i] != y.bigits[i])
+            return x.bigits[i] < y.bigits[i] ? -1 : +1;
+    }
+
+    return 0;
+}
+
+// x := x + y
+static inline void Add(DiyInt& x, const DiyInt& y)
+{
+    while (x.size < y.size)
+        x.bigits[x.size++] = 0;
+
+    uint32_t carry = 0;
+    for (int32_t i = 0; i < x.size; ++i)
+    {
+        const uint64_t s = uint64_t{x.bigits[i]} + (i < y.size ? y.bigits[i] : 0) + carry;
+        x.bigits[i]      = Lo32(s);
+        carry            = Hi32(s);
+    }
+
+    if (carry != 0)
+    {
+        RYU_ASSERT(x.size < DiyInt::Capacity);
+        x.bigits[x.size++] = carry;
+    }
+}
+
+// x := m2, where value = m2 * 2^e2. Returns e2.
+// PRE: value is finite and > 0.
+static inline int32_t AssignBinary64(DiyInt& x, double value)
+{
+    const Double v(value);
+    const uint64_t F = v.PhysicalSignificand();
+    const uint64_t E = v.PhysicalExponent();
+    const uint64_t m2 = (E == 0) ? F : (Double::HiddenBit | F);
+    const int32_t  e2 = (E == 0 ? 1 : static_cast<int32_t>(E)) - Double::ExponentBias;
+
+    x.bigits[0] = Lo32(m2);
+    x.bigits[1] = Hi32(m2);
+    x.size = (x.bigits[1] != 0) ? 2 : 1;
+
+    return e2;
+}
+
+// Returns the sign of (lhs * 10^e10 - rhs * 2^e2).
+static inline int32_t CompareScaled(DiyInt& lhs, int32_t e10, DiyInt& rhs, int32_t e2)
+{
+    // Scale both sides to integers:
+    //  lhs * 5^e10 * 2^e10  <=>  rhs * 2^e2
+    int32_t lhs_e2 = 0;
+    int32_t rhs_e2 = 0;
+    if (e10 >= 0)
+    {
+        MulPow5(lhs, e10);
+        lhs_e2 += e10;
+    }
+    else
+    {
+        MulPow5(rhs, -e10);
+        rhs_e2 -= e10;
+    }
+
+    if (e2 >= 0)
+        rhs_e2 += e2;
+    else
+        lhs_e2 -= e2;
+
+    const int32_t common_e2 = lhs_e2 < rhs_e2 ? lhs_e2 : rhs_e2;
+    MulPow2(lhs, lhs_e2 - common_e2);
+    MulPow2(rhs, rhs_e2 - common_e2);
+
+    return Compare(lhs, rhs);
+}
+
+// Returns the sign of (lhs * 10^e10 - value).
+// PRE: value is finite and > 0.
+static inline int32_t CompareScaled(DiyInt& lhs, int32_t e10, double value)
+{
+    DiyInt rhs;
+    const int32_t e2 = AssignBinary64(rhs, value);
+
+    return CompareScaled(lhs, e10, rhs, e2);
+}
+
+#if RYU_STRTOD_FALLBACK()
+// Returns the sign of (input - value), where input = digits * 10^exponent denotes the decimal
+// number in [next, last), which has num_digits significant digits.
+// PRE: value is finite and > 0.
+static RYU_NEVER_INLINE int32_t CompareDecimal(const char* next, const char* last, int64_t num_digits, int64_t exponent, double value)
+{
+    RYU_ASSERT(num_digits > 0);
+
+    static constexpr uint32_t Pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    };
+
+    // Skip leading zeros (and the decimal point).
+    while (next != last && (*next == '0' || *next == '.'))
+        ++next;
+
+    DiyInt lhs;
+
+    int32_t  num_parsed  = 0;
+    uint32_t chunk       = 0;
+    int32_t  chunk_len   = 0;
+    bool     nonzero_tail = false;
+    for ( ; next != last; ++next)
+    {
+        if (*next == '.')
+            continue;
+        if (!IsDigit(*next))
+            break;
+
+        if (num_parsed < DiyInt::MaxSignificantDigits)
+        {
+            chunk = 10 * chunk + static_cast<uint32_t>(DigitValue(*next));
+            ++chunk_len;
+            ++num_parsed;
+            if (chunk_len == 9)
+            {
+                MulAddU32(lhs, Pow10[9], chunk);
+                chunk = 0;
+                chunk_len = 0;
+            }
+        }
+        else if (*next != '0')
+        {
+            nonzero_tail = true;
+        }
+    }
+
+    MulAddU32(lhs, Pow10[chunk_len], chunk);
+
+    RYU_ASSERT(num_parsed == (num_digits < DiyInt::MaxSignificantDigits ? num_digits : DiyInt::MaxSignificantDigits));
+
+    // input = lhs * 10^e10 (+ tail)
+    const int64_t e10_64 = exponent + (num_digits - num_parsed);
+    RYU_ASSERT(e10_64 >= MinDecimalExponent - DiyInt::MaxSignificantDigits);
+    RYU_ASSERT(e10_64 <= MaxDecimalExponent);
+    const int32_t e10 = static_cast<int32_t>(e10_64);
+
+    const int32_t cmp = CompareScaled(lhs, e10, value);
+    return (cmp == 0 && nonzero_tail) ? +1 : cmp;
+}
+
+// Converts the long decimal number in [next, last) into binary floating-point, using directed
+// rounding.
+static RYU_NEVER_INLINE double ToBinary64SlowDirected(const char* next, const char* last, int64_t num_digits, int64_t exponent, RoundMagnitude rounding)
+{
+    RYU_ASSERT(rounding != RoundMagnitude::nearest_even);
+
+    const double flt = ToBinary64Slow(next, last);
+
+    // The exact result lies in [pred(flt), succ(flt)].
+    // Find the correct one by comparing the input against flt.
+
+    if (flt == 0)
+    {
+        // 0 < input <= denorm_min / 2
+        return rounding == RoundMagnitude::toward_zero ? 0.0 : std::numeric_limits<double>::denorm_min();
+    }
+
+    if (flt == std::numeric_limits<double>::infinity())
+    {
+        // input > max
+        return rounding == RoundMagnitude::toward_zero ? std::numeric_limits<double>::max() : flt;
+    }
+
+    const int32_t cmp = CompareDecimal(next, last, num_digits, exponent, flt);
+    const uint64_t bits = ReinterpretBits<uint64_t>(flt);
+
+    if (cmp < 0 && rounding == RoundMagnitude::toward_zero)
+        return ReinterpretBits<double>(bits - 1);
+    if (cmp > 0 && rounding == RoundMagnitude::away_from_zero)
+        return ReinterpretBits<double>(bits + 1); // NB: succ(max) = +Infinity
+
+    return flt;
+}
+#endif
+
+static inline RoundMagnitude ToRoundMagnitude(RoundingMode mode, bool is_negative)
+{
+    switch (mode)
+    {
+    case RoundingMode::nearest_even:
+    default:
+        return RoundMagnitude::nearest_even;
+    case RoundingMode::toward_zero:
+        return RoundMagnitude::toward_zero;
+    case RoundingMode::upward:
+        return is_negative ? RoundMagnitude::toward_zero : RoundMagnitude::away_from_zero;
+    case RoundingMode::downward:
+        return is_negative ? RoundMagnitude::away_from_zero : RoundMagnitude::toward_zero;
+    }
+}
+
+// Exponents larger than this limit will be treated as +Infinity.
+// But we must still scan all the digits if this happens to be the case.
+static constexpr int32_t MaxExp = 999999;
+static_assert(MaxExp >= 999, "invalid parameter");
+static_assert(MaxExp <= (INT_MAX - 9) / 10, "invalid parameter");
+
+namespace {
+// The decimal number (-1)^is_negative * significand * 10^exponent,
+// where significand has num_digits decimal digits.
+struct DecimalNumber
+{
+    uint64_t significand = 0; // only valid iff num_digits <= 19
+    int64_t  num_digits  = 0; // 64-bit to avoid overflow...
+    int64_t  exponent    = 0; // 64-bit to avoid overflow...
+    int32_t  parsed_exponent = 0;
+    bool     is_negative = false;
+    const char* digits = nullptr; // Start of the input, without the sign
+};
+}
+
+// Decomposes the input into a DecimalNumber.
+// If the input is +-inf or nan, value is set to the corresponding number and dec is left unchanged.
+static inline StrtodResult DecomposeDecimal(const char* next, const char* last, DecimalNumber& dec, double& value)
 {
     if (next == last)
         return {next, StrtodStatus::invalid};
@@ -2081,9 +2478,7 @@ StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
 
 // int32_t
 
-#if RYU_STRTOD_FALLBACK()
     const char* const start = next;
-#endif
 
     const bool has_leading_zero = (*next == '0');
     const bool has_leading_dot  = (*next == '.');
@@ -2162,12 +2557,6 @@ StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
 
 // exp
 
-    // Exponents larger than this limit will be treated as +Infinity.
-    // But we must still scan all the digits if this happens to be the case.
-    static constexpr int32_t MaxExp = 999999;
-    static_assert(MaxExp >= 999, "invalid parameter");
-    static_assert(MaxExp <= (INT_MAX - 9) / 10, "invalid parameter");
-
     int32_t parsed_exponent = 0;
     if (next != last && (*next == 'e' || *next == 'E'))
     {
@@ -2218,7 +2607,25 @@ StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
 
     RYU_ASSERT(num_digits >= 0);
 
-    double flt;
+    dec.significand = significand;
+    dec.num_digits = num_digits;
+    dec.exponent = exponent;
+    dec.parsed_exponent = parsed_exponent;
+    dec.is_negative = is_negative;
+    dec.digits = start;
+
+    return {next, status};
+}
+
+// Converts the magnitude of the decimal number dec, which ends at last, into binary floating-point.
+// Returns false iff the input is too long and no fallback algorithm is available.
+static inline bool DecimalToBinary64(const DecimalNumber& dec, const char* last, RoundMagnitude rounding, double& flt)
+{
+    const uint64_t significand     = dec.significand;
+    const int64_t  num_digits      = dec.num_digits;
+    const int64_t  exponent        = dec.exponent;
+    const int32_t  parsed_exponent = dec.parsed_exponent;
+
     if (num_digits == 0)
     {
         flt = 0;
@@ -2228,84 +2635,500 @@ StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
         // input = x * 10^-inf = 0
         // or
         // input < 10^MinDecimalExponent, which rounds to +-0.
-        flt = 0;
+        // (Or to +-denorm_min, when rounding away from zero.)
+        flt = rounding == RoundMagnitude::away_from_zero ? std::numeric_limits<double>::denorm_min() : 0.0;
     }
     else if (parsed_exponent > +MaxExp || exponent + num_digits > MaxDecimalExponent)
     {
         // input = x * 10^+inf = +inf
         // or
         // input >= 10^MaxDecimalExponent, which rounds to +-infinity.
-        flt = std::numeric_limits<double>::infinity();
+        // (Or to +-max, when rounding toward zero.)
+        flt = rounding == RoundMagnitude::toward_zero ? std::numeric_limits<double>::max() : std::numeric_limits<double>::infinity();
     }
     else if (num_digits <= ToBinaryMaxDecimalDigits)
     {
         RYU_ASSERT(exponent >= INT_MIN);
         RYU_ASSERT(exponent <= INT_MAX);
-        flt = ToBinary64(significand, static_cast<int32_t>(num_digits), static_cast<int32_t>(exponent));
+        flt = ToBinary64(significand, static_cast<int32_t>(num_digits), static_cast<int32_t>(exponent), rounding);
     }
     else
     {
         // We need to fall back to another algorithm if the input is too long.
 #if RYU_STRTOD_FALLBACK()
-        flt = ToBinary64Slow(start, next);
+        if (rounding == RoundMagnitude::nearest_even)
+            flt = ToBinary64Slow(dec.digits, last);
+        else
+            flt = ToBinary64SlowDirected(dec.digits, last, num_digits, exponent, rounding);
 #else
-        return {next, StrtodStatus::input_too_long};
+        static_cast<void>(last);
+        return false;
 #endif
     }
 
-    value = is_negative ? -flt : flt;
-    return {next, status};
+    return true;
+}
+
+static inline StrtodResult StrtodImpl(const char* next, const char* last, double& value, RoundingMode mode)
+{
+    DecimalNumber dec;
+    const auto res = DecomposeDecimal(next, last, dec, value);
+    if (res.status == StrtodStatus::invalid || res.status == StrtodStatus::inf || res.status == StrtodStatus::nan)
+        return res;
+
+    double flt;
+#if RYU_STRTOD_FALLBACK()
+    const bool converted = DecimalToBinary64(dec, res.next, ToRoundMagnitude(mode, dec.is_negative), flt);
+    RYU_ASSERT(converted);
+    static_cast<void>(converted);
+#else
+    if (!DecimalToBinary64(dec, res.next, ToRoundMagnitude(mode, dec.is_negative), flt))
+        return {res.next, StrtodStatus::input_too_long};
+#endif
+
+    value = dec.is_negative ? -flt : flt;
+    return res;
+}
+
+StrtodResult ryu::Strtod(const char* next, const char* last, double& value)
+{
+    return StrtodImpl(next, last, value, RoundingMode::nearest_even);
+}
+
+StrtodResult ryu::Strtod(const char* next, const char* last, double& value, RoundingMode mode)
+{
+    return StrtodImpl(next, last, value, mode);
 }
 
 //==================================================================================================
-// Round10
+// CompareDecimalText
 //==================================================================================================
 
-static inline uint64_t SmallPow10(int32_t e10)
-{
-    static constexpr uint64_t Pow10Table[] = {
-        1,
-        10,
-        100,
-        1000,
-        10000,
-        100000,
-        1000000,
-        10000000,
-        100000000,
-        1000000000,
-        10000000000,
-        100000000000,
-        1000000000000,
-        10000000000000,
-        100000000000000,
-        1000000000000000,
-        10000000000000000,
-        100000000000000000,
-    };
+using ryu::DecimalOrder;
 
-    RYU_ASSERT(e10 >= 0);
-    RYU_ASSERT(e10 <= 17);
-    return Pow10Table[static_cast<uint32_t>(e10)];
+namespace {
+struct DecimalThreshold
+{
+    double value = 0;
+    // If value is a normal number: The shortest decimal representation of |value|, padded to 17
+    // digits, i.e. digits * 10^(exponent - 16), where 10^16 <= digits < 10^17.
+    uint64_t digits = 0;
+    int64_t  exponent = 0;
+    bool     has_digits = false;
+};
 }
 
-static inline double MulRoundDiv(const double value, const int32_t mul_e10, const int32_t div_e10)
+static inline DecimalThreshold MakeDecimalThreshold(double value)
 {
+    DecimalThreshold threshold;
+    threshold.value = value;
+
     const Double v(value);
+    if (v.IsFinite() && v.PhysicalExponent() != 0)
+    {
+        const auto dec = ToDecimal64(v.PhysicalSignificand(), v.PhysicalExponent());
+        const int32_t length = DecimalLength(dec.digits);
 
-    const uint64_t F = v.PhysicalSignificand();
-    const uint64_t E = v.PhysicalExponent();
+        threshold.digits = dec.digits * SmallPow10(17 - length);
+        threshold.exponent = dec.exponent + length - 1;
+        threshold.has_digits = true;
+    }
 
-    if (E == Double::MaxIeeeExponent || (E == 0 && F == 0))
+    return threshold;
+}
+
+// Returns the first n significant digits of the non-zero decimal number dec (truncated).
+static inline uint64_t LeadingDigits(const DecimalNumber& dec, int32_t n)
+{
+    RYU_ASSERT(dec.num_digits > 0);
+    RYU_ASSERT(n >= 1);
+    RYU_ASSERT(n <= 17);
+
+    if (dec.num_digits <= 19)
     {
-        // +-0, or Infinity, or NaN
-        // Multiplying by 10^n does not change the value.
-        return value;
+        const int32_t num_digits = static_cast<int32_t>(dec.num_digits);
+        if (num_digits <= n)
+            return dec.significand * SmallPow10(n - num_digits);
+
+        uint64_t digits = dec.significand;
+        for (int32_t i = n; i < num_digits; ++i)
+            digits /= 10;
+        return digits;
     }
 
-    // Convert to decimal
-    const FloatingDecimal64 dec = ToDecimal64(F, E);
+    // The significand is not available. Scan the input.
+    uint64_t digits = 0;
+    for (const char* p = dec.digits; n > 0; ++p)
+    {
+        if (*p == '.' || (digits == 0 && *p == '0'))
+            continue;
+        digits = 10 * digits + DigitValue(*p);
+        --n;
+    }
+    return digits;
+}
+
+static inline DecimalOrder Order(double x, double y)
+{
+    if (x < y)
+        return DecimalOrder::less;
+    if (x > y)
+        return DecimalOrder::greater;
+    if (x == y)
+        return DecimalOrder::equal;
+    return DecimalOrder::unordered;
+}
+
+static inline DecimalOrder CompareDecimalTextImpl(const char* next, const char* last, const DecimalThreshold& threshold)
+{
+    DecimalNumber dec;
+    double value = 0;
+    const auto res = DecomposeDecimal(next, last, dec, value);
+    if (res.status == StrtodStatus::invalid || res.next != last)
+        return DecimalOrder::unordered;
+
+    if (res.status == StrtodStatus::inf || res.status == StrtodStatus::nan)
+        return Order(value, threshold.value);
+
+    if (dec.num_digits != 0 && threshold.has_digits)
+    {
+        const DecimalOrder less    = dec.is_negative ? DecimalOrder::greater : DecimalOrder::less;
+        const DecimalOrder greater = dec.is_negative ? DecimalOrder::less : DecimalOrder::greater;
+
+        if (dec.is_negative != (threshold.value < 0))
+        {
+            // Note: The input might round to zero, but the threshold is non-zero.
+            return greater;
+        }
+
+        // Let S denote the shortest decimal representation of the threshold t and let u denote a
+        // unit in the 17th significant digit of S. All inputs which round to t lie in the rounding
+        // interval of t, which contains S and is at most 1 ulp(t) wide. Since t is normal,
+        // ulp(t) <= 2^-52 t < 10^17 u / 2^52 < 23 u.
+        //
+        // Compare the first 17 digits of the input, P = floor(|input| / u), against S / u.
+        // If they differ by at least 24 units, the input cannot round to t and the comparison is
+        // decided. Otherwise, the input is converted.
+        static constexpr uint64_t Margin = 24;
+
+        // 10^(d-1) <= |input| < 10^d
+        const int64_t d = dec.exponent + dec.num_digits;
+        const int64_t shift = threshold.exponent + 1 - d;
+
+        if (shift > 1) // P < 10^15
+            return less;
+        if (shift < 0) // P >= 10^17
+            return greater;
+
+        const uint64_t digits = LeadingDigits(dec, 17 - static_cast<int32_t>(shift));
+        if (digits + Margin <= threshold.digits)
+            return less;
+        if (digits >= threshold.digits + Margin)
+            return greater;
+    }
+
+    // Close to the threshold (or zero or infinite or subnormal).
+    // Convert the input and compare.
+    double flt;
+    if (!DecimalToBinary64(dec, res.next, RoundMagnitude::nearest_even, flt))
+        return DecimalOrder::unordered;
+
+    return Order(dec.is_negative ? -flt : flt, threshold.value);
+}
+
+DecimalOrder ryu::CompareDecimalText(const char* first, const char* last, double threshold)
+{
+    return CompareDecimalTextImpl(first, last, MakeDecimalThreshold(threshold));
+}
+
+//==================================================================================================
+// StrtodBatch
+//==================================================================================================
+
+using ryu::TokenSpan;
+
+static inline int32_t CountTrailingZeros64(uint64_t x)
+{
+    RYU_ASSERT(x != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int32_t>(index);
+#else
+    int32_t tz = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++tz;
+    }
+    return tz;
+#endif
+}
+
+// Returns a bitmask of the separators (delimiter or '\n') in the 64 bytes starting at p.
+// Bit i is set iff p[i] is a separator.
+static inline uint64_t SeparatorMask(const char* p, char delimiter)
+{
+#if HAS_SSE2()
+    const __m128i d  = _mm_set1_epi8(delimiter);
+    const __m128i nl = _mm_set1_epi8('\n');
+
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        const __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, nl));
+        mask |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(m))} << (16 * i);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        mask |= uint64_t{p[i] == delimiter || p[i] == '\n'} << i;
+    }
+    return mask;
+#endif
+}
+
+static inline bool IsTokenSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+// Calls fn(token_first, token_last) for each token in [first, last), until fn returns false.
+template <typename Fn>
+static inline void ForEachTokenImpl(const char* first, const char* last, char delimiter, Fn fn)
+{
+    if (first == last)
+        return;
+
+    const auto emit = [&](const char* token_first, const char* token_last) {
+        while (token_first != token_last && IsTokenSpace(*token_first))
+            ++token_first;
+        while (token_first != token_last && IsTokenSpace(token_last[-1]))
+            --token_last;
+        return fn(token_first, token_last);
+    };
+
+    const char* token_first = first;
+    for (const char* block = first; block != last; )
+    {
+        const size_t n = static_cast<size_t>(last - block) < 64 ? static_cast<size_t>(last - block) : 64;
+
+        uint64_t mask;
+        if (n == 64)
+        {
+            mask = SeparatorMask(block, delimiter);
+        }
+        else
+        {
+            char buf[64] = {0};
+            std::memcpy(buf, block, n);
+            mask = SeparatorMask(buf, delimiter) & ((uint64_t{1} << n) - 1);
+        }
+
+        for ( ; mask != 0; mask &= mask - 1)
+        {
+            const char* const separator = block + CountTrailingZeros64(mask);
+            if (!emit(token_first, separator))
+                return;
+            token_first = separator + 1;
+        }
+
+        block += n;
+    }
+
+    if (token_first != last || last[-1] != '\n')
+        emit(token_first, last);
+}
+
+void ryu::ForEachToken(const char* first, const char* last, char delimiter, TokenCallback callback, void* context)
+{
+    ForEachTokenImpl(first, last, delimiter, [&](const char* token_first, const char* token_last) {
+        return callback(context, token_first, token_last);
+    });
+}
+
+size_t ryu::FindTokens(const char* first, const char* last, char delimiter, TokenSpan* spans, size_t max_spans)
+{
+    size_t count = 0;
+    ForEachTokenImpl(first, last, delimiter, [&](const char* token_first, const char* token_last) {
+        if (count == max_spans)
+            return false;
+        spans[count++] = {token_first, token_last};
+        return true;
+    });
+
+    return count;
+}
+
+size_t ryu::StrtodBatch(const char* first, const char* last, char delimiter, double* values, size_t max_values)
+{
+    size_t count = 0;
+    ForEachTokenImpl(first, last, delimiter, [&](const char* token_first, const char* token_last) {
+        if (count == max_values)
+            return false;
+
+        double flt;
+        const auto res = StrtodImpl(token_first, token_last, flt, RoundingMode::nearest_even);
+        if (res.status == StrtodStatus::invalid || res.next != token_last)
+            flt = std::numeric_limits<double>::quiet_NaN();
+
+        values[count++] = flt;
+        return true;
+    });
+
+    return count;
+}
+
+size_t ryu::CompareDecimalTextBatch(const char* first, const char* last, char delimiter, double threshold, DecimalOrder* results, size_t max_results)
+{
+    const DecimalThreshold t = MakeDecimalThreshold(threshold);
+
+    size_t count = 0;
+    ForEachTokenImpl(first, last, delimiter, [&](const char* token_first, const char* token_last) {
+        if (count == max_results)
+            return false;
+
+        results[count++] = CompareDecimalTextImpl(token_first, token_last, t);
+        return true;
+    });
+
+    return count;
+}
+
+//==================================================================================================
+// CachedStrtod
+//==================================================================================================
+
+namespace {
+struct StrtodCacheEntry
+{
+    uint64_t key = 0;
+    double value = 0;
+    uint8_t length = 0; // = 0: empty
+    uint8_t consumed = 0;
+    StrtodStatus status = StrtodStatus::invalid;
+};
+}
+
+static constexpr int StrtodCacheBits = 8;
+
+// Loads the token [next, next + length) into a uint64_t, padded with zeros.
+// If at least 8 bytes are readable at next (i.e. available >= 8), the token is loaded with a single
+// 8-byte load, and the bytes beyond the token are masked out. Otherwise the bytes are loaded one at
+// a time. (Both variants produce the same key, i.e. the bytes are stored in memory order.)
+static inline uint64_t LoadToken(const char* next, size_t length, size_t available)
+{
+    RYU_ASSERT(length >= 1);
+    RYU_ASSERT(length <= 8);
+    RYU_ASSERT(available >= length);
+
+    uint64_t key = 0;
+    if (available >= 8) // [[likely]]
+    {
+        std::memcpy(&key, next, 8);
+        const uint64_t ones = ~uint64_t{0};
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        key &= ones << (64 - 8 * length);
+#else
+        key &= ones >> (64 - 8 * length);
+#endif
+    }
+    else
+    {
+        std::memcpy(&key, next, length);
+    }
+    return key;
+}
+
+static inline uint32_t StrtodCacheIndex(uint64_t key, size_t length)
+{
+    // Fibonacci hashing.
+    const uint64_t h = (key + length) * 0x9E3779B97F4A7C15ull;
+    return static_cast<uint32_t>(h >> (64 - StrtodCacheBits));
+}
+
+StrtodResult ryu::CachedStrtod(const char* next, const char* last, double& value)
+{
+    return CachedStrtod(next, last, last, value);
+}
+
+StrtodResult ryu::CachedStrtod(const char* next, const char* last, const char* buffer_last, double& value)
+{
+    RYU_ASSERT(last <= buffer_last);
+
+    const size_t length = static_cast<size_t>(last - next);
+    if (length == 0 || length > 8)
+        return StrtodImpl(next, last, value, RoundingMode::nearest_even);
+
+    static thread_local StrtodCacheEntry cache[1u << StrtodCacheBits];
+
+    const uint64_t key = LoadToken(next, length, static_cast<size_t>(buffer_last - next));
+    StrtodCacheEntry& entry = cache[StrtodCacheIndex(key, length)];
+
+    if (entry.key == key && entry.length == length)
+    {
+        value = entry.value;
+        return {next + entry.consumed, entry.status};
+    }
+
+    const StrtodResult res = StrtodImpl(next, last, value, RoundingMode::nearest_even);
+    if (res.status != StrtodStatus::invalid)
+    {
+        entry.key = key;
+        entry.value = value;
+        entry.length = static_cast<uint8_t>(length);
+        entry.consumed = static_cast<uint8_t>(res.next - next);
+        entry.status = res.status;
+    }
+
+    return res;
+}
+
+//==================================================================================================
+// Round10
+//==================================================================================================
+
+// Returns whether the magnitude i + f/pow10, where 0 <= f < pow10, should be rounded up to i + 1.
+// (The sign is required for the directed rounding modes.)
+static inline bool RoundUp(const uint64_t i, const uint64_t f, const uint64_t pow10, const bool negative, const ryu::DecimalRounding mode)
+{
+    RYU_ASSERT(f < pow10);
+    RYU_ASSERT(pow10 % 2 == 0);
+
+    switch (mode)
+    {
+    case ryu::DecimalRounding::half_away_from_zero:
+        return f >= pow10 / 2;
+    case ryu::DecimalRounding::half_even:
+        return f > pow10 / 2 || (f == pow10 / 2 && i % 2 != 0);
+    case ryu::DecimalRounding::toward_zero:
+        return false;
+    case ryu::DecimalRounding::upward:
+        return !negative && f != 0;
+    case ryu::DecimalRounding::downward:
+        return negative && f != 0;
+    }
+
+    RYU_ASSERT(false);
+    return false;
+}
+
+struct RoundedDecimal64
+{
+    uint64_t digits; // May be 0
+    int32_t num_digits;
+    int32_t exponent;
+};
 
+// Computes round(x * 10^mul_e10) / 10^div_e10 in decimal, where x = dec.digits * 10^dec.exponent.
+static inline RoundedDecimal64 MulRoundDivDecimal(const FloatingDecimal64 dec, const int32_t mul_e10, const int32_t div_e10, const bool negative, const ryu::DecimalRounding mode)
+{
     uint64_t digits     = dec.digits;
     int32_t  num_digits = DecimalLength(dec.digits);
     int32_t  exponent   = dec.exponent; // (Using 64 bits to avoid checking for overflow.)
@@ -2313,7 +3136,7 @@ static inline double MulRoundDiv(const double value, const int32_t mul_e10, cons
     // Multiply by 10^mul_e10
     exponent += mul_e10;
 
-    // Round x = digits * 10^exponent to the nearest integer.
+    // Round x = digits * 10^exponent to an integer.
 
     // We have
     // x = digits * 10^exponent
@@ -2334,8 +3157,8 @@ static inline double MulRoundDiv(const double value, const int32_t mul_e10, cons
         const uint64_t i = digits / pow10;
         const uint64_t f = digits % pow10;
 
-        // Round to int (towards +inf)
-        digits      = i + (f >= pow10 / 2);
+        // Round to int
+        digits      = i + (RoundUp(i, f, pow10, negative, mode) ? 1 : 0);
         num_digits  = DecimalLength(digits);
         exponent    = 0;
     }
@@ -2343,19 +3166,18 @@ static inline double MulRoundDiv(const double value, const int32_t mul_e10, cons
     {
         // 1/10 <= x < 1
 
-        // x < 1/2 <==> 10x < 5
-        //         <==> 10 (digits / 10^e10) < 5
-        //         <==> digits < 5 * 10^(e10 - 1)
+        // x = 0 + digits / 10^e10,
+        // and, e.g., x < 1/2 <==> digits < 5 * 10^(e10 - 1)
 
-        digits      = (digits >= 5 * SmallPow10(e10 - 1)) ? 1 : 0;
+        digits      = RoundUp(0, digits, SmallPow10(e10), negative, mode) ? 1 : 0;
         num_digits  = 1;
         exponent    = 0;
     }
     else
     {
         // x < 1/10
-        // This definitely rounds to 0.
-        digits      = 0;
+        // This definitely rounds to 0, unless rounding away from zero.
+        digits      = RoundUp(0, 1, 10, negative, mode) ? 1 : 0;
         num_digits  = 1;
         exponent    = 0;
     }
@@ -2363,27 +3185,55 @@ static inline double MulRoundDiv(const double value, const int32_t mul_e10, cons
     // Divide by 10^div_e10
     exponent -= div_e10;
 
-    // And convert back to binary.
-    double flt;
-    if (digits == 0)
+    return {digits, num_digits, exponent};
+}
+
+// Converts the (non-negative) decimal number into the nearest double.
+static inline double ToBinary64(const RoundedDecimal64& dec)
+{
+    if (dec.digits == 0)
     {
-        flt = 0;
+        return 0;
     }
-    else if (exponent + num_digits <= MinDecimalExponent)
+    else if (dec.exponent + dec.num_digits <= MinDecimalExponent)
     {
         // x * 10^-inf = 0
-        flt = 0;
+        return 0;
     }
-    else if (exponent + num_digits > MaxDecimalExponent)
+    else if (dec.exponent + dec.num_digits > MaxDecimalExponent)
     {
         // x * 10^+inf = +inf
-        flt = std::numeric_limits<double>::infinity();
+        return std::numeric_limits<double>::infinity();
     }
     else
     {
-        flt = ToBinary64(digits, num_digits, exponent);
+        return ToBinary64(dec.digits, dec.num_digits, dec.exponent);
+    }
+}
+
+static inline double MulRoundDiv(const double value, const int32_t mul_e10, const int32_t div_e10, const ryu::DecimalRounding mode = ryu::DecimalRounding::half_away_from_zero)
+{
+    const Double v(value);
+
+    const uint64_t F = v.PhysicalSignificand();
+    const uint64_t E = v.PhysicalExponent();
+
+    if (E == Double::MaxIeeeExponent || (E == 0 && F == 0))
+    {
+        // +-0, or Infinity, or NaN
+        // Multiplying by 10^n does not change the value.
+        return value;
     }
 
+    // Convert to decimal
+    const FloatingDecimal64 dec = ToDecimal64(F, E);
+
+    // Round
+    const RoundedDecimal64 rounded = MulRoundDivDecimal(dec, mul_e10, div_e10, value < 0, mode);
+
+    // And convert back to binary.
+    const double flt = ToBinary64(rounded);
+
     return value < 0 ? -flt : flt;
 }
 
@@ -2394,3 +3244,903 @@ double ryu::Round10(const double value, const int n)
 
     return MulRoundDiv(value, -n, -n);
 }
+
+double ryu::Round10(const double value, const int n, const DecimalRounding mode)
+{
+    if (n < -1000 || n > +1000) // (Not supported yet)
+        return value;
+
+    return MulRoundDiv(value, -n, -n, mode);
+}
+
+char* ryu::DtoaRounded(char* buffer, const double value, const int decimals, const DecimalRounding mode)
+{
+    const Double v(value);
+
+    const uint64_t F = v.PhysicalSignificand();
+    const uint64_t E = v.PhysicalExponent();
+
+    if (E == Double::MaxIeeeExponent || (E == 0 && F == 0) || decimals < -1000 || decimals > 1000)
+    {
+        // +-0, or Infinity, or NaN, or not supported (yet).
+        // Rounding does not change the value.
+        return ToChars(buffer, value);
+    }
+
+    const FloatingDecimal64 dec = ToDecimal64(F, E);
+
+    buffer[0] = '-';
+    buffer += v.SignBit();
+
+    if (dec.exponent >= -decimals)
+    {
+        // The value is already a multiple of 10^-decimals.
+        return FormatDigits(buffer, dec.digits, dec.exponent);
+    }
+
+    RoundedDecimal64 rounded = MulRoundDivDecimal(dec, decimals, decimals, value < 0, mode);
+    if (rounded.digits == 0)
+    {
+        buffer[0] = '0';
+        return buffer + 1;
+    }
+
+    // Remove trailing zeros.
+    while (rounded.digits % 10 == 0)
+    {
+        rounded.digits /= 10;
+        rounded.num_digits--;
+        rounded.exponent++;
+    }
+
+    // Any decimal number with at most 15 significant digits in the range of the normalized
+    // double-precision numbers round-trips, i.e. it is the shortest (and closest) decimal
+    // representation of the double it converts into. In this case Dtoa(Round10(x)) would print
+    // exactly these digits and the conversion back to binary is not required.
+    const int32_t decimal_point = rounded.exponent + rounded.num_digits;
+    if (rounded.num_digits <= 15 && decimal_point >= -306 && decimal_point <= 308)
+    {
+        return FormatDigits(buffer, rounded.digits, rounded.exponent);
+    }
+
+    const double flt = ToBinary64(rounded);
+    const double rounded_value = value < 0 ? -flt : flt;
+    return ToChars(buffer - v.SignBit(), rounded_value);
+}
+
+StrtodResult ryu::StrtodRounded(const char* next, const char* last, const int decimals, double& value, const DecimalRounding mode)
+{
+    DecimalNumber dec;
+    const auto res = DecomposeDecimal(next, last, dec, value);
+    if (res.status == StrtodStatus::invalid || res.status == StrtodStatus::inf || res.status == StrtodStatus::nan)
+        return res;
+
+    if (decimals < -1000 || decimals > 1000) // (Not supported yet)
+        return StrtodImpl(next, last, value, RoundingMode::nearest_even);
+
+    if (dec.num_digits >= 1 && dec.num_digits <= 19 && dec.parsed_exponent >= -MaxExp && dec.parsed_exponent <= MaxExp)
+    {
+        uint64_t significand = dec.significand;
+        int64_t  num_digits  = dec.num_digits;
+        int64_t  exponent    = dec.exponent;
+
+        // Remove trailing zeros.
+        while (significand % 10 == 0)
+        {
+            significand /= 10;
+            num_digits--;
+            exponent++;
+        }
+
+        // If the input has at most 15 significant digits and is in the range of the normalized
+        // double-precision numbers, the digits are the shortest decimal representation of the
+        // double they convert into. I.e. Round10 would round exactly these digits, and the first
+        // conversion into binary is not required.
+        const int64_t decimal_point = exponent + num_digits;
+        if (num_digits <= 15 && decimal_point >= -306 && decimal_point <= 308)
+        {
+            const FloatingDecimal64 input = {significand, static_cast<int32_t>(exponent)};
+            const RoundedDecimal64 rounded = MulRoundDivDecimal(input, decimals, decimals, dec.is_negative, mode);
+
+            const double flt = ToBinary64(rounded);
+            value = dec.is_negative ? -flt : flt;
+            return res;
+        }
+    }
+
+    double flt;
+#if RYU_STRTOD_FALLBACK()
+    const bool converted = DecimalToBinary64(dec, res.next, RoundMagnitude::nearest_even, flt);
+    RYU_ASSERT(converted);
+    static_cast<void>(converted);
+#else
+    if (!DecimalToBinary64(dec, res.next, RoundMagnitude::nearest_even, flt))
+        return {res.next, StrtodStatus::input_too_long};
+#endif
+
+    value = MulRoundDiv(dec.is_negative ? -flt : flt, decimals, decimals, mode);
+    return res;
+}
+
+double ryu::RoundSignificant(const double value, const int digits, const ryu::DecimalRounding mode)
+{
+    const Double v(value);
+
+    const uint64_t F = v.PhysicalSignificand();
+    const uint64_t E = v.PhysicalExponent();
+
+    if (E == Double::MaxIeeeExponent || (E == 0 && F == 0) || digits < 1)
+    {
+        // +-0, or Infinity, or NaN
+        return value;
+    }
+
+    // Convert to decimal
+    const FloatingDecimal64 dec = ToDecimal64(F, E);
+
+    const int32_t num_digits = DecimalLength(dec.digits);
+    if (num_digits <= digits)
+        return value;
+
+    // Remove the last (num_digits - digits) digits, and round using the given rounding mode.
+    const uint64_t pow10 = SmallPow10(num_digits - digits);
+    const uint64_t i = dec.digits / pow10;
+    const uint64_t f = dec.digits % pow10;
+
+    const uint64_t rounded  = i + (RoundUp(i, f, pow10, value < 0, mode) ? 1 : 0);
+    const int32_t  exponent = dec.exponent + (num_digits - digits);
+
+    // And convert back to binary.
+    // NB: rounded may have digits + 1 digits here (if it is 10^digits).
+    const int32_t rounded_digits = DecimalLength(rounded);
+
+    double flt;
+    if (exponent + rounded_digits > MaxDecimalExponent)
+    {
+        flt = std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+        // (rounded >= 1 and value >= denorm_min, so the result cannot underflow.)
+        flt = ToBinary64(rounded, rounded_digits, exponent);
+    }
+
+    return value < 0 ? -flt : flt;
+}
+
+void ryu::RoundSignificantBatch(const double* values, double* results, size_t count, int digits, ryu::DecimalRounding mode)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = RoundSignificant(values[i], digits, mode);
+    }
+}
+
+// Round10(x, n) can be computed in binary floating-point as
+//  y = x * 10^-n  (or y = x / 10^n),
+//  r = round(y),
+//  result = r / 10^-n  (or r * 10^n),
+// if 10^|n| is exact (|n| <= 22), if r is exact (|y| < 2^51), and if y is not too close to a
+// tie, so that rounding y gives the same integer as rounding the shortest decimal representation
+// of x, as done by MulRoundDiv. The last step is then correctly rounded, just like ToBinary64.
+//
+// The shortest decimal representation of x and the computed y are each within 2^-53 |x * 10^-n|
+// of the exact product. So y is close to a tie if |0.5 - |y - r|| <= 2^-50 |y|, which includes
+// some slack.
+
+static constexpr int32_t Round10FastMaxExponent = 22;
+
+namespace {
+struct Round10Params
+{
+    double pow10;     // 10^|n|
+    bool   multiply;  // true if n <= 0, i.e. y = x * 10^-n
+};
+}
+
+static inline double Round10Pow10(int32_t e10)
+{
+    static constexpr double Pow10Table[] = {
+        1e+00, 1e+01, 1e+02, 1e+03, 1e+04, 1e+05, 1e+06, 1e+07, 1e+08, 1e+09, 1e+10, 1e+11,
+        1e+12, 1e+13, 1e+14, 1e+15, 1e+16, 1e+17, 1e+18, 1e+19, 1e+20, 1e+21, 1e+22,
+    };
+
+    RYU_ASSERT(e10 >= 0);
+    RYU_ASSERT(e10 <= Round10FastMaxExponent);
+    return Pow10Table[e10];
+}
+
+// Returns whether the fast method applies. In this case result is set to Round10(value, n).
+static inline bool Round10Fast(double value, const Round10Params& params, double& result)
+{
+    static constexpr double TwoPow51 = 2251799813685248.0; // 2^51
+    static constexpr double TwoPow52 = 4503599627370496.0; // 2^52
+    static constexpr double TwoPowM50 = 8.8817841970012523e-16; // 2^-50
+
+    const double y = params.multiply ? value * params.pow10 : value / params.pow10;
+    const double a = std::abs(y);
+    if (!(a < TwoPow51)) // (Also handles NaN.)
+        return false;
+
+    // Round to nearest integer. Exact, since a < 2^51.
+    const double r = (a + TwoPow52) - TwoPow52;
+    if (!(0.5 - std::abs(a - r) > TwoPowM50 * a))
+        return false;
+
+    const double flt = params.multiply ? r / params.pow10 : r * params.pow10;
+    result = std::signbit(value) ? -flt : flt;
+    return true;
+}
+
+void ryu::Round10Batch(const double* values, double* results, size_t count, int n)
+{
+    if (n < -Round10FastMaxExponent || n > Round10FastMaxExponent)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = Round10(values[i], n);
+        }
+        return;
+    }
+
+    const Round10Params params = {Round10Pow10(n <= 0 ? -n : n), n <= 0};
+
+    size_t i = 0;
+
+#if HAS_SSE2()
+    const __m128d pow10    = _mm_set1_pd(params.pow10);
+    const __m128d sign     = _mm_set1_pd(-0.0);
+    const __m128d half     = _mm_set1_pd(0.5);
+    const __m128d two51    = _mm_set1_pd(2251799813685248.0);
+    const __m128d two52    = _mm_set1_pd(4503599627370496.0);
+    const __m128d twoM50   = _mm_set1_pd(8.8817841970012523e-16);
+
+    for ( ; count - i >= 2; i += 2)
+    {
+        const __m128d x = _mm_loadu_pd(values + i);
+        const __m128d y = params.multiply ? _mm_mul_pd(x, pow10) : _mm_div_pd(x, pow10);
+        const __m128d a = _mm_andnot_pd(sign, y);
+        const __m128d r = _mm_sub_pd(_mm_add_pd(a, two52), two52);
+        const __m128d d = _mm_sub_pd(half, _mm_andnot_pd(sign, _mm_sub_pd(a, r)));
+
+        const __m128d ok = _mm_and_pd(_mm_cmplt_pd(a, two51), _mm_cmpgt_pd(d, _mm_mul_pd(twoM50, a)));
+
+        const __m128d flt = params.multiply ? _mm_div_pd(r, pow10) : _mm_mul_pd(r, pow10);
+        const __m128d res = _mm_or_pd(flt, _mm_and_pd(x, sign));
+
+        const int mask = _mm_movemask_pd(ok);
+        if (mask == 3) // [[likely]]
+        {
+            _mm_storeu_pd(results + i, res);
+        }
+        else
+        {
+            // At least one lane needs the slow path.
+            double tmp[2];
+            _mm_storeu_pd(tmp, res);
+            results[i + 0] = (mask & 1) ? tmp[0] : MulRoundDiv(values[i + 0], -n, -n);
+            results[i + 1] = (mask & 2) ? tmp[1] : MulRoundDiv(values[i + 1], -n, -n);
+        }
+    }
+#endif
+
+    for ( ; i < count; ++i)
+    {
+        const double value = values[i];
+        if (!Round10Fast(value, params, results[i]))
+        {
+            results[i] = MulRoundDiv(value, -n, -n);
+        }
+    }
+}
+
+//==================================================================================================
+// Decimal64 (BID)
+//==================================================================================================
+
+// The decimal64 format has a 16-digit coefficient and an exponent in [-398, 369] (with the
+// coefficient interpreted as an integer).
+static constexpr int32_t  Decimal64ExponentBias   = 398;
+static constexpr int32_t  Decimal64MaxExponent    = 369;
+static constexpr uint64_t Decimal64MaxCoefficient = 9999999999999999; // 10^16 - 1
+
+static constexpr uint64_t Decimal64SignMask       = uint64_t{1} << 63;
+static constexpr uint64_t Decimal64SteeringMask   = uint64_t{0x3} << 61; // G0 G1
+static constexpr uint64_t Decimal64InfMask        = uint64_t{0xF} << 59; // G0 ... G3
+static constexpr uint64_t Decimal64NaNMask        = uint64_t{0x1F} << 58; // G0 ... G4
+static constexpr uint64_t Decimal64Inf            = uint64_t{0xF} << 59;
+static constexpr uint64_t Decimal64QuietNaN       = uint64_t{0x1F} << 58;
+
+static inline uint64_t EncodeDecimal64(bool sign, uint64_t coefficient, int32_t exponent)
+{
+    RYU_ASSERT(coefficient <= Decimal64MaxCoefficient);
+    RYU_ASSERT(exponent >= -Decimal64ExponentBias);
+    RYU_ASSERT(exponent <= Decimal64MaxExponent);
+
+    const uint64_t biased_exponent = static_cast<uint64_t>(exponent + Decimal64ExponentBias);
+
+    uint64_t bid;
+    if (coefficient < (uint64_t{1} << 53))
+    {
+        // s EEEEEEEEEE CCC...C (53 bits)
+        bid = biased_exponent << 53 | coefficient;
+    }
+    else
+    {
+        // s 11 EEEEEEEEEE CCC...C (51 bits), with an implicit 100 prefix of the coefficient
+        bid = Decimal64SteeringMask | biased_exponent << 51 | (coefficient & ((uint64_t{1} << 51) - 1));
+    }
+
+    return sign ? (Decimal64SignMask | bid) : bid;
+}
+
+uint64_t ryu::DoubleToDecimal64BID(double value)
+{
+    const Double v(value);
+
+    const uint64_t F = v.PhysicalSignificand();
+    const uint64_t E = v.PhysicalExponent();
+    const bool sign = v.SignBit();
+
+    if (E == Double::MaxIeeeExponent)
+    {
+        if (F != 0)
+            return Decimal64QuietNaN;
+
+        return sign ? (Decimal64SignMask | Decimal64Inf) : Decimal64Inf;
+    }
+
+    if (E == 0 && F == 0)
+    {
+        return EncodeDecimal64(sign, 0, 0);
+    }
+
+    const FloatingDecimal64 dec = ToDecimal64(F, E);
+
+    uint64_t digits   = dec.digits;
+    int32_t  exponent = dec.exponent;
+
+    if (digits > Decimal64MaxCoefficient)
+    {
+        // The shortest representation has 17 digits.
+        // This is the representation with 17 digits closest to value, so the last digit decides
+        // how to round value to 16 digits, unless it is a 5. In this case value might be on either
+        // side of the midpoint digits * 10^exponent, and we need to compare exactly.
+
+        const uint64_t q = digits / 10;
+        const uint32_t r = static_cast<uint32_t>(digits % 10);
+
+        bool round_up;
+        if (r != 5)
+        {
+            round_up = r > 5;
+        }
+        else
+        {
+            DiyInt lhs;
+            lhs.bigits[0] = Lo32(digits);
+            lhs.bigits[1] = Hi32(digits);
+            lhs.size = 2;
+
+            const int32_t cmp = CompareScaled(lhs, exponent, sign ? -value : value);
+            round_up = cmp < 0 || (cmp == 0 && q % 2 != 0);
+        }
+
+        digits = q + round_up;
+        exponent += 1;
+
+        if (digits > Decimal64MaxCoefficient)
+        {
+            // Rounding up did overflow the 16-digit coefficient.
+            digits /= 10;
+            exponent += 1;
+        }
+    }
+    else
+    {
+        // Prefer the exponent 0 for integers.
+        while (exponent > 0 && digits <= Decimal64MaxCoefficient / 10)
+        {
+            digits *= 10;
+            exponent -= 1;
+        }
+    }
+
+    return EncodeDecimal64(sign, digits, exponent);
+}
+
+double ryu::Decimal64BIDToDouble(uint64_t bid)
+{
+    const bool sign = (bid & Decimal64SignMask) != 0;
+
+    uint64_t coefficient;
+    int32_t  biased_exponent;
+    if ((bid & Decimal64SteeringMask) != Decimal64SteeringMask)
+    {
+        coefficient     = bid & ((uint64_t{1} << 53) - 1);
+        biased_exponent = static_cast<int32_t>((bid >> 53) & 0x3FF);
+    }
+    else if ((bid & Decimal64InfMask) != Decimal64InfMask)
+    {
+        coefficient     = (uint64_t{1} << 53) | (bid & ((uint64_t{1} << 51) - 1));
+        biased_exponent = static_cast<int32_t>((bid >> 51) & 0x3FF);
+
+        if (coefficient > Decimal64MaxCoefficient)
+        {
+            // Non-canonical
+            coefficient = 0;
+        }
+    }
+    else if ((bid & Decimal64NaNMask) != Decimal64NaNMask)
+    {
+        return sign ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const int32_t exponent = biased_exponent - Decimal64ExponentBias;
+
+    double flt;
+    if (coefficient == 0)
+    {
+        flt = 0;
+    }
+    else
+    {
+        const int32_t num_digits = DecimalLength(coefficient);
+
+        if (exponent + num_digits <= MinDecimalExponent)
+        {
+            flt = 0;
+        }
+        else if (exponent + num_digits > MaxDecimalExponent)
+        {
+            flt = std::numeric_limits<double>::infinity();
+        }
+        else
+        {
+            flt = ToBinary64(coefficient, num_digits, exponent);
+        }
+    }
+
+    return sign ? -flt : flt;
+}
+
+void ryu::DoubleToDecimal64BIDBatch(const double* values, size_t count, uint64_t* bids)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        bids[i] = DoubleToDecimal64BID(values[i]);
+    }
+}
+
+void ryu::Decimal64BIDToDoubleBatch(const uint64_t* bids, size_t count, double* values)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = Decimal64BIDToDouble(bids[i]);
+    }
+}
+
+//==================================================================================================
+// ShortestInInterval
+//==================================================================================================
+
+// Returns the sign of m * 10^e10 - value, i.e. compares the decimal number m * 10^e10 with the
+// given finite non-negative double-precision number.
+// The comparison is exact.
+static inline int CompareDecimalWithDouble(uint64_t m, int32_t e10, double value)
+{
+    RYU_ASSERT(value >= 0);
+
+    if (m == 0)
+        return value == 0 ? 0 : -1;
+
+    // Remove trailing zeros. (This allows m = 10^17.)
+    while (m % 10 == 0)
+    {
+        m /= 10;
+        e10++;
+    }
+
+    const int32_t num_digits = DecimalLength(m);
+
+    // m * 10^e10 < 10^MinDecimalExponent < denorm_min
+    if (e10 + num_digits <= MinDecimalExponent)
+        return value == 0 ? 1 : -1;
+    // m * 10^e10 >= 10^MaxDecimalExponent > max double
+    if (e10 + num_digits > MaxDecimalExponent)
+        return 1;
+
+    // If the conversion is exact, both directed roundings return the same number. Otherwise the
+    // decimal number lies strictly between the two doubles.
+    const double lower = ToBinary64(m, num_digits, e10, RoundMagnitude::toward_zero);
+    const double upper = ToBinary64(m, num_digits, e10, RoundMagnitude::away_from_zero);
+    if (lower == upper)
+        return (lower > value) - (lower < value);
+
+    return value <= lower ? 1 : -1;
+}
+
+// Returns the sign of m * 10^e10 - (lo + hi), i.e. compares the decimal number m * 10^e10 with the
+// exact sum of the given finite numbers 0 <= lo <= hi, hi > 0.
+// The comparison is exact.
+static inline int CompareDecimalWithSum(uint64_t m, int32_t e10, double lo, double hi)
+{
+    RYU_ASSERT(m > 0);
+    RYU_ASSERT(lo >= 0);
+    RYU_ASSERT(hi > 0);
+
+    DiyInt lhs;
+    lhs.bigits[0] = Lo32(m);
+    lhs.bigits[1] = Hi32(m);
+    lhs.size = (lhs.bigits[1] != 0) ? 2 : 1;
+
+    DiyInt rhs;
+    int32_t e2 = AssignBinary64(rhs, hi);
+    if (lo > 0)
+    {
+        DiyInt rhs_lo;
+        const int32_t e2_lo = AssignBinary64(rhs_lo, lo);
+
+        // lo + hi = (rhs_lo * 2^(e2_lo - e2) + rhs) * 2^e2, with e2 = min(e2_lo, e2).
+        if (e2_lo < e2)
+        {
+            MulPow2(rhs, e2 - e2_lo);
+            e2 = e2_lo;
+        }
+        else
+        {
+            MulPow2(rhs_lo, e2_lo - e2);
+        }
+
+        Add(rhs, rhs_lo);
+    }
+
+    return CompareScaled(lhs, e10, rhs, e2);
+}
+
+// Returns an estimate for floor(value / 10^e10), given the shortest decimal representation of
+// value (or {0,0} if value = 0). The result is <= 10^17, if value < 10^(e10 + 17).
+static inline int64_t EstimateMultiple(FloatingDecimal64 dec, int32_t e10)
+{
+    if (dec.digits == 0)
+        return 0;
+
+    if (dec.exponent >= e10)
+    {
+        RYU_ASSERT(dec.exponent - e10 <= 17);
+        return static_cast<int64_t>(dec.digits * SmallPow10(dec.exponent - e10));
+    }
+
+    if (e10 - dec.exponent <= 17)
+        return static_cast<int64_t>(dec.digits / SmallPow10(e10 - dec.exponent));
+
+    return 0;
+}
+
+// Returns the smallest m, such that m * 10^e10 >= value (if min_cmp = 0), or m * 10^e10 > value
+// (if min_cmp = 1). value must be < 10^(e10 + 17), so that the result is <= 10^17.
+//
+// The estimate is usually off by at most a few units. For subnormal numbers, however, 1 ulp may
+// be many units of 10^e10. So first search (exponentially) for an interval containing the result,
+// then use binary search.
+static inline int64_t SmallestMultipleAbove(int64_t estimate, int32_t e10, double value, int min_cmp)
+{
+    static constexpr int64_t MaxMultiple = 100000000000000000; // 10^17
+
+    RYU_ASSERT(estimate >= 0);
+    RYU_ASSERT(estimate <= MaxMultiple);
+
+    // Invariant: below < result <= above
+    int64_t below;
+    int64_t above;
+    if (CompareDecimalWithDouble(static_cast<uint64_t>(estimate), e10, value) >= min_cmp)
+    {
+        above = estimate;
+        below = estimate - 1;
+        for (int64_t delta = 2; below >= 0 && CompareDecimalWithDouble(static_cast<uint64_t>(below), e10, value) >= min_cmp; delta *= 2)
+        {
+            above = below;
+            below = above - delta < 0 ? -1 : above - delta;
+        }
+    }
+    else
+    {
+        below = estimate;
+        above = estimate + 1;
+        for (int64_t delta = 2; CompareDecimalWithDouble(static_cast<uint64_t>(above), e10, value) < min_cmp; delta *= 2)
+        {
+            RYU_ASSERT(above < MaxMultiple);
+            below = above;
+            above = below + delta > MaxMultiple ? MaxMultiple : below + delta;
+        }
+    }
+
+    while (above - below > 1)
+    {
+        const int64_t m = below + (above - below) / 2;
+        if (CompareDecimalWithDouble(static_cast<uint64_t>(m), e10, value) >= min_cmp)
+            above = m;
+        else
+            below = m;
+    }
+
+    return above;
+}
+
+// Computes the shortest decimal number in [lo, hi] (or (lo, hi), if !inclusive), where
+// 0 <= lo <= hi and hi > 0 are finite.
+// Returns false if the interval does not contain any decimal number with at most 17 digits.
+static inline bool ShortestInPositiveInterval(double lo, double hi, bool inclusive, FloatingDecimal64& result)
+{
+    RYU_ASSERT(lo >= 0);
+    RYU_ASSERT(hi > 0);
+    RYU_ASSERT(lo <= hi);
+
+    const Double vhi(hi);
+    const FloatingDecimal64 dec_hi = ToDecimal64(vhi.PhysicalSignificand(), vhi.PhysicalExponent());
+
+    FloatingDecimal64 dec_lo = {0, 0};
+    if (lo != 0)
+    {
+        const Double vlo(lo);
+        dec_lo = ToDecimal64(vlo.PhysicalSignificand(), vlo.PhysicalExponent());
+    }
+
+    // Find the decimal exponent of hi, such that 10^e <= hi < 10^(e + 1).
+    // The shortest representation of hi has the same exponent, unless it has been rounded up to
+    // the next power of ten.
+    int32_t e = DecimalLength(dec_hi.digits) + dec_hi.exponent - 1;
+    if (CompareDecimalWithDouble(1, e, hi) > 0)
+        e--;
+
+    // The interval contains a multiple of 10^j, iff the smallest multiple of 10^j above lo is below
+    // hi. If this holds for j, it holds for all smaller j, too. The candidates m * 10^j for j < e - 16
+    // would have more than 17 digits.
+    // Find the largest such j in [e - 16, e] using binary search.
+    const int lo_cmp = inclusive ? 0 : 1; // m * 10^j >= lo, or m * 10^j > lo
+    const int hi_cmp = inclusive ? 1 : 0; // m * 10^j >  hi, or m * 10^j >= hi
+
+    int32_t j_valid = e - 16;
+    int32_t j_invalid = e + 1;
+
+    int64_t m_lo = SmallestMultipleAbove(EstimateMultiple(dec_lo, j_valid), j_valid, lo, lo_cmp);
+    if (CompareDecimalWithDouble(static_cast<uint64_t>(m_lo), j_valid, hi) >= hi_cmp)
+        return false;
+
+    while (j_invalid - j_valid > 1)
+    {
+        const int32_t j = j_valid + (j_invalid - j_valid) / 2;
+        const int64_t m = SmallestMultipleAbove(EstimateMultiple(dec_lo, j), j, lo, lo_cmp);
+        if (CompareDecimalWithDouble(static_cast<uint64_t>(m), j, hi) < hi_cmp)
+        {
+            j_valid = j;
+            m_lo = m;
+        }
+        else
+        {
+            j_invalid = j;
+        }
+    }
+
+    // All multiples of 10^j_valid in the interval have the same (minimal) number of digits.
+    const int64_t m_hi = SmallestMultipleAbove(EstimateMultiple(dec_hi, j_valid), j_valid, hi, hi_cmp) - 1;
+    RYU_ASSERT(m_lo > 0);
+    RYU_ASSERT(m_lo <= m_hi);
+
+    // The interval does not contain a multiple of 10^(j_valid + 1), so there are at most 9 such
+    // candidates (and none of them has trailing zeros). Choose the one closest to the midpoint
+    // (lo + hi) / 2 of the interval, and the even one if there are two.
+    // m + 1 is closer to the midpoint than m, iff (m + 1/2) * 10^j < (lo + hi) / 2.
+    int64_t m = m_lo;
+    for ( ; m < m_hi; ++m)
+    {
+        const int cmp = CompareDecimalWithSum(static_cast<uint64_t>(2 * m + 1), j_valid, lo, hi);
+        if (cmp > 0 || (cmp == 0 && m % 2 == 0))
+            break;
+    }
+
+    const uint64_t digits = static_cast<uint64_t>(m);
+    RYU_ASSERT(digits % 10 != 0);
+
+    result = {digits, j_valid};
+    return true;
+}
+
+ryu::ShortestDecimal ryu::ShortestInInterval(double lo, double hi, bool inclusive)
+{
+    const ShortestDecimal invalid = {0, 0, false, false};
+
+    if (!Double(lo).IsFinite() || !Double(hi).IsFinite() || !(lo <= hi) || (!inclusive && lo == hi))
+        return invalid;
+
+    // Zero is the shortest decimal number.
+    if (inclusive ? (lo <= 0 && 0 <= hi) : (lo < 0 && 0 < hi))
+        return {0, 0, false, true};
+
+    // Mirror negative intervals.
+    const bool negative = hi <= 0;
+    if (negative)
+    {
+        const double t = lo;
+        lo = -hi;
+        hi = -t;
+    }
+
+    // (lo may be -0 here.)
+    lo = lo == 0 ? 0.0 : lo;
+
+    FloatingDecimal64 dec;
+    if (!ShortestInPositiveInterval(lo, hi, inclusive, dec))
+        return invalid;
+
+    return {dec.digits, dec.exponent, negative, true};
+}
+
+char* ryu::ShortestInInterval(char* buffer, double lo, double hi, bool inclusive)
+{
+    const ShortestDecimal dec = ShortestInInterval(lo, hi, inclusive);
+    if (!dec.valid)
+        return nullptr;
+
+    if (dec.digits == 0)
+    {
+        buffer[0] = '0';
+        return buffer + 1;
+    }
+
+    buffer[0] = '-';
+    buffer += dec.negative;
+
+    return FormatDigits(buffer, dec.digits, dec.exponent);
+}
+
+//==================================================================================================
+// Itoa
+//==================================================================================================
+
+char* ryu::Utoa64(char* buffer, uint64_t value)
+{
+    if (value < 10)
+    {
+        *buffer = static_cast<char>('0' + value);
+        return buffer + 1;
+    }
+
+    if (value >= 10000000000000000ull)
+    {
+        // 17 to 20 digits.
+        // Print the (at most 4) leading digits and then 16 digits in two 8-digit blocks.
+        const uint64_t q = value / 10000000000000000ull;
+        const uint64_t r = value % 10000000000000000ull;
+
+        const int32_t length = DecimalLength(q);
+        buffer += length;
+        PrintDecimalDigitsBackwards(buffer, q);
+
+        Utoa_8Digits(buffer + 0, static_cast<uint32_t>(r / 100000000));
+        Utoa_8Digits(buffer + 8, static_cast<uint32_t>(r % 100000000));
+        return buffer + 16;
+    }
+
+    const int32_t length = DecimalLength(value);
+    buffer += length;
+    PrintDecimalDigitsBackwards(buffer, value);
+    return buffer;
+}
+
+char* ryu::Itoa64(char* buffer, int64_t value)
+{
+    uint64_t abs_value = static_cast<uint64_t>(value);
+    if (value < 0)
+    {
+        *buffer++ = '-';
+        abs_value = 0 - abs_value;
+    }
+
+    return Utoa64(buffer, abs_value);
+}
+
+char* ryu::Itoa32(char* buffer, int32_t value)
+{
+    uint32_t abs_value = static_cast<uint32_t>(value);
+    if (value < 0)
+    {
+        *buffer++ = '-';
+        abs_value = 0 - abs_value;
+    }
+
+    return Utoa64(buffer, abs_value);
+}
+
+//==================================================================================================
+// Atoi
+//==================================================================================================
+
+// Loads 8 bytes. The first byte is stored in the least significant byte of the result.
+static inline uint64_t Load8Bytes(const char* next)
+{
+    uint64_t x = 0;
+    for (int32_t i = 0; i < 8; ++i)
+    {
+        x |= uint64_t{static_cast<unsigned char>(next[i])} << (8 * i);
+    }
+    return x;
+}
+
+// Returns whether all bytes are in ['0', '9'].
+static inline bool IsEightDigits(uint64_t x)
+{
+    // '0' <= x <= '9'  <==>  x & 0xF0 == 0x30 and (x + 6) & 0xF0 == 0x30
+    return ((x & 0xF0F0F0F0F0F0F0F0ull) | (((x + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// Converts 8 digits (as loaded by Load8Bytes) into an integer.
+static inline uint32_t ParseEightDigits(uint64_t x)
+{
+    x -= 0x3030303030303030ull;
+
+    // 8 x 1 digit -> 4 x 2 digits -> 2 x 4 digits -> 1 x 8 digits
+    x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFull;
+    x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFull;
+    x = (x * 10000 + (x >> 32)) & 0x00000000FFFFFFFFull;
+
+    return static_cast<uint32_t>(x);
+}
+
+StrtodResult ryu::Atoi64(const char* next, const char* last, int64_t& value)
+{
+    const char* const first = next;
+
+    if (next == last)
+        return {first, StrtodStatus::invalid};
+
+    const bool is_negative = (*next == '-');
+    if (is_negative || *next == '+')
+    {
+        ++next;
+        if (next == last)
+            return {first, StrtodStatus::invalid};
+    }
+
+    if (!IsDigit(*next))
+        return {first, StrtodStatus::invalid};
+
+    // Skip leading zeros.
+    while (next != last && *next == '0')
+        ++next;
+
+    const char* const digits = next;
+
+    // (The significand may wrap around here, if the input has more than 19 digits.)
+    uint64_t significand = 0;
+    while (last - next >= 8)
+    {
+        const uint64_t chunk = Load8Bytes(next);
+        if (!IsEightDigits(chunk))
+            break;
+
+        significand = 100000000 * significand + ParseEightDigits(chunk);
+        next += 8;
+    }
+
+    for ( ; next != last && IsDigit(*next); ++next)
+    {
+        significand = 10 * significand + static_cast<uint32_t>(DigitValue(*next));
+    }
+
+    // uint64_t can store all 19-digit numbers. Numbers with more (non-zero) digits are >= 10^19 and
+    // do not fit into an int64_t.
+    if (next - digits > 19)
+        return {first, StrtodStatus::invalid};
+
+    const uint64_t max_value = is_negative ? uint64_t{1} << 63 : (uint64_t{1} << 63) - 1;
+    if (significand > max_value)
+        return {first, StrtodStatus::invalid};
+
+    value = static_cast<int64_t>(is_negative ? 0 - significand : significand);
+    return {next, StrtodStatus::integer};
+}
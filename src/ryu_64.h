@@ -8,6 +8,9 @@
 
 #define RYU_STRTOD_FALLBACK() 1
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ryu {
 
 // char* output_end = Dtoa(buffer, value);
@@ -75,6 +78,144 @@ struct StrtodResult
 
 StrtodResult Strtod(const char* next, const char* last, double& value);
 
+// StrtodResult conversion_result = Strtod(first, last, value, mode);
+//
+// Same as above, but rounds the decimal input into binary floating-point using the given rounding
+// mode. E.g., for any decimal input x:
+//  Strtod(..., RoundingMode::downward) returns the largest  double <= x, and
+//  Strtod(..., RoundingMode::upward)   returns the smallest double >= x.
+//
+// Note:
+// Inputs which are exactly representable are converted exactly in all rounding modes.
+
+enum class RoundingMode {
+    nearest_even,   // Round to nearest, ties to even (as above)
+    toward_zero,    // Round toward zero, i.e. truncate
+    upward,         // Round toward +Infinity
+    downward,       // Round toward -Infinity
+};
+
+StrtodResult Strtod(const char* next, const char* last, double& value, RoundingMode mode);
+
+// StrtodResult conversion_result = CachedStrtod(first, last, value);
+//
+// Same as Strtod(first, last, value), but inputs of at most 8 characters are first looked up in a
+// small direct-mapped cache. Use this function if the input consists of short tokens which repeat
+// very often (e.g. "0", "1", "-1", "100", "NaN").
+//
+// Note:
+// Each thread has its own cache; no locking is involved.
+// The cache is keyed on the complete range [first, last). Longer inputs are never cached.
+
+StrtodResult CachedStrtod(const char* next, const char* last, double& value);
+
+// StrtodResult conversion_result = CachedStrtod(first, last, buffer_last, value);
+//
+// Same as above, but the range [last, buffer_last) must be readable, too (e.g. the rest of the
+// line or of the input buffer). If at least 8 bytes are readable at first, the token is loaded with
+// a single 8-byte load. Only the token [first, last) is parsed and used as the cache key.
+
+StrtodResult CachedStrtod(const char* next, const char* last, const char* buffer_last, double& value);
+
+// DecimalOrder order = CompareDecimalText(first, last, threshold);
+//
+// Compares the decimal floating-point number in [first, last) against the given threshold.
+// The result is the same as comparing Strtod(first, last) against threshold, i.e. the input is
+// rounded to the nearest double first. But most inputs are decided by comparing their first 17
+// significant digits against the shortest decimal representation of the threshold, without
+// actually converting the input into binary floating-point.
+//
+// Returns DecimalOrder::unordered if the input is not a valid number, if the input has not been
+// consumed completely, or if the input or the threshold is NaN.
+
+enum class DecimalOrder {
+    less,       // input <  threshold
+    equal,      // input == threshold
+    greater,    // input >  threshold
+    unordered,  // invalid input or NaN
+};
+
+DecimalOrder CompareDecimalText(const char* first, const char* last, double threshold);
+
+// size_t count = CompareDecimalTextBatch(first, last, delimiter, threshold, results, max_results);
+//
+// Splits [first, last) into tokens, as FindTokens below, and compares each token against threshold,
+// as above. Stores the result for the i-th token in results[i] and returns the number of tokens
+// processed, which is at most max_results.
+//
+// Inputs with an unknown number of tokens can be processed using ForEachToken and
+// CompareDecimalText.
+
+size_t CompareDecimalTextBatch(const char* first, const char* last, char delimiter, double threshold, DecimalOrder* results, size_t max_results);
+
+// size_t count = FindTokens(first, last, delimiter, spans, max_spans);
+//
+// Splits [first, last) into tokens, which are separated by the given delimiter or by '\n'.
+// Leading and trailing spaces, tabs and '\r' are removed from each token. A line break at the end
+// of the buffer does not start a new (empty) token, and an empty buffer contains no tokens.
+//
+// Stores the tokens in spans and returns the number of tokens found, which is at most max_spans.
+// The separators are found using SIMD instructions (if available), 64 bytes at a time.
+
+struct TokenSpan
+{
+    const char* first;
+    const char* last;
+};
+
+size_t FindTokens(const char* first, const char* last, char delimiter, TokenSpan* spans, size_t max_spans);
+
+// ForEachToken(first, last, delimiter, callback, context);
+//
+// Splits [first, last) into tokens, as above, and calls callback(context, token_first, token_last)
+// for each token, in order, until the callback returns false.
+//
+// Unlike FindTokens, this processes the whole input in a single call, without a limit on the
+// number of tokens, so callers do not need to resume the tokenization themselves.
+
+using TokenCallback = bool (*)(void* context, const char* first, const char* last);
+
+void ForEachToken(const char* first, const char* last, char delimiter, TokenCallback callback, void* context);
+
+// size_t count = StrtodBatch(first, last, delimiter, values, max_values);
+//
+// Splits [first, last) into tokens, as above, and converts each token using Strtod. Tokenization
+// and conversion are interleaved in a single pass over the input.
+//
+// Stores the result for the i-th token in values[i] and returns the number of tokens processed,
+// which is at most max_values. Tokens which are not valid numbers, or which are not consumed
+// completely by Strtod, are converted to NaN.
+
+size_t StrtodBatch(const char* first, const char* last, char delimiter, double* values, size_t max_values);
+
+// char* output_end = Itoa32(buffer, value);
+// char* output_end = Itoa64(buffer, value);
+// char* output_end = Utoa64(buffer, value);
+//
+// Converts the given integer into decimal form and stores the result in the given buffer.
+// Uses the same digit generation as Dtoa.
+//
+// The buffer must be large enough, i.e. >= ItoaMinBufferLength.
+// The output is _not_ null-terminted.
+
+constexpr int ItoaMinBufferLength = 20;
+
+char* Itoa32(char* buffer, int32_t value);
+char* Itoa64(char* buffer, int64_t value);
+char* Utoa64(char* buffer, uint64_t value);
+
+// StrtodResult conversion_result = Atoi64(first, last, value);
+//
+// Converts the given decimal integer, i.e. an optional sign followed by at least one digit, into a
+// 64-bit signed integer. Parsing stops at the first character which is not a digit. Digits are
+// read 8 at a time (using SWAR arithmetic) as long as possible.
+//
+// On success, the status is StrtodStatus::integer. If the input is not an integer, or if the
+// number does not fit into an int64_t, the status is StrtodStatus::invalid and value is not
+// modified.
+
+StrtodResult Atoi64(const char* next, const char* last, int64_t& value);
+
 // Round10(x, n) returns: round(x * 10^-n) / 10^-n
 //
 // Use this function to round the given value to a specific number of decimal places.
@@ -82,4 +223,153 @@ StrtodResult Strtod(const char* next, const char* last, double& value);
 //       Round10(55.0, 1) == 60.0
 double Round10(double value, int n);
 
+// Rounding modes for rounding to a number of decimal places.
+enum class DecimalRounding {
+    half_away_from_zero, // Round to nearest, ties away from zero (as above)
+    half_even,           // Round to nearest, ties to even
+    toward_zero,         // Truncate
+    upward,              // Round toward +Infinity, i.e. ceil
+    downward,            // Round toward -Infinity, i.e. floor
+};
+
+// Round10(x, n, mode) returns x rounded to a multiple of 10^n, using the given rounding mode.
+//
+// Same as above, but the rounding mode may be selected. Just like Round10(x, n), the rounding is
+// applied to the shortest decimal representation of x (as produced by Dtoa), i.e. the result
+// is the same as rounding the decimal string. E.g.:
+//  Round10(2.675, -2, DecimalRounding::half_even) == 2.68 // 2.675 is a tie in decimal
+//  Round10(2.665, -2, DecimalRounding::half_even) == 2.66
+//  Round10(-1.239, -2, DecimalRounding::downward) == -1.24
+//  Round10(-1.239, -2, DecimalRounding::toward_zero) == -1.23
+double Round10(double value, int n, DecimalRounding mode);
+
+// char* output_end = DtoaRounded(buffer, value, decimals, mode);
+//
+// Rounds the given number to the given number of decimal places and converts the result into
+// decimal form, i.e. the output is the same as Dtoa(buffer, Round10(value, -decimals, mode)).
+//
+// The rounded digits are formatted directly, without converting them back to binary (and again
+// into decimal), whenever this is known to produce the same output. This is the case if the
+// rounded number has at most 15 significant digits and is in the range of the normalized
+// double-precision numbers.
+//
+// The buffer must be large enough, i.e. >= DtoaMinBufferLength.
+// The output is _not_ null-terminted.
+
+char* DtoaRounded(char* buffer, double value, int decimals, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
+// StrtodResult conversion_result = StrtodRounded(first, last, decimals, value, mode);
+//
+// Converts the given decimal floating-point number into a double-precision number and rounds the
+// result to the given number of decimal places, i.e. the result is the same as
+// Round10(Strtod(first, last), -decimals, mode).
+//
+// If the input has at most 15 significant digits and is in the range of the normalized
+// double-precision numbers, the input is rounded in decimal and converted into binary only once.
+
+StrtodResult StrtodRounded(const char* next, const char* last, int decimals, double& value, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
+// RoundSignificant(x, digits, mode) returns x rounded to the given number of significant decimal
+// digits, using the given rounding mode.
+//
+// The shortest decimal representation of x (as produced by Dtoa) is rounded, just like in Round10,
+// i.e. the number of digits is exact (no floating-point log10). By default, ties are rounded away
+// from zero.
+// E.g.: RoundSignificant(1.005, 3) == 1.01
+//       RoundSignificant(9.96, 2) == 10.0
+//       RoundSignificant(123456.0, 2) == 120000.0
+//       RoundSignificant(-1.239, 3, DecimalRounding::downward) == -1.24
+// If digits < 1, or if x has at most digits significant digits, x is returned unchanged.
+// Note that rounding numbers close to the maximum double may result in +-Infinity.
+double RoundSignificant(double value, int digits, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
+// RoundSignificantBatch(values, results, count, digits, mode);
+//
+// Computes results[i] = RoundSignificant(values[i], digits, mode) for all 0 <= i < count.
+void RoundSignificantBatch(const double* values, double* results, size_t count, int digits, DecimalRounding mode = DecimalRounding::half_away_from_zero);
+
+// Round10Batch(values, results, count, n);
+//
+// Computes results[i] = Round10(values[i], n) for all 0 <= i < count.
+// values and results may be the same array (but must not overlap otherwise).
+//
+// Note:
+// For |n| <= 22, most values are rounded directly in binary floating-point (two values at a time,
+// if SSE2 is available). Only values close to a tie, and values which are very large compared to
+// 10^n, take the slower path through the shortest decimal representation.
+
+void Round10Batch(const double* values, double* results, size_t count, int n);
+
+// uint64_t bid = DoubleToDecimal64BID(value);
+//
+// Converts the given double-precision number into an IEEE 754-2008 decimal64 number, using the
+// binary integer decimal (BID) encoding.
+//
+// If the shortest decimal representation of value (as produced by Dtoa) has at most 16 significant
+// digits, the result is exactly this decimal number. Integers are stored with an exponent of 0, as
+// long as the coefficient fits into 16 digits. Otherwise, value is rounded to the nearest decimal64
+// number (ties to even).
+// Infinities and NaNs are converted into the corresponding decimal64 values.
+//
+// Note:
+// Every finite double is within the range of decimal64. No overflow or underflow occurs.
+
+uint64_t DoubleToDecimal64BID(double value);
+
+// double value = Decimal64BIDToDouble(bid);
+//
+// Converts the given decimal64 number (BID encoding) into the nearest double-precision number
+// (ties to even). Non-canonical coefficients (>= 10^16) are treated as 0.
+// NaNs are converted into a quiet NaN.
+//
+// Note:
+// Decimal64BIDToDouble(DoubleToDecimal64BID(value)) == value, as long as the shortest decimal
+// representation of value has at most 16 significant digits.
+
+double Decimal64BIDToDouble(uint64_t bid);
+
+// DoubleToDecimal64BIDBatch(values, count, bids);
+// Decimal64BIDToDoubleBatch(bids, count, values);
+//
+// Converts count numbers as above.
+
+void DoubleToDecimal64BIDBatch(const double* values, size_t count, uint64_t* bids);
+void Decimal64BIDToDoubleBatch(const uint64_t* bids, size_t count, double* values);
+
+// ShortestDecimal dec = ShortestInInterval(lo, hi, inclusive);
+//
+// Returns the shortest decimal number in the interval [lo, hi] (or (lo, hi), if !inclusive), i.e.
+// the number with the fewest significant digits. If there are multiple such numbers, the one
+// closest to the exact midpoint (lo + hi) / 2 of the interval is chosen (and the one with an even
+// last digit, if there are two). E.g.:
+//  ShortestInInterval(0.15, 0.45, true) == 3 * 10^-1
+//  ShortestInInterval(0.16, 0.39, true) == 3 * 10^-1  (0.2 and 0.3 are candidates, midpoint 0.275)
+//  ShortestInInterval(123.4, 123.6, true) == 1235 * 10^-1
+//  ShortestInInterval(-0.5, 2.0, true) == 0
+//
+// This is the same problem Dtoa solves for the rounding interval of a single double, but for
+// arbitrary intervals, e.g. for axis labels or histogram bin edges.
+// The result is valid iff lo and hi are finite, lo <= hi (lo < hi, if !inclusive), and if the
+// interval contains a decimal number with at most 17 significant digits. This is always the case,
+// unless lo == hi. digits has no trailing zeros, and is 0 iff the result is 0.
+
+struct ShortestDecimal {
+    uint64_t digits;
+    int32_t exponent;
+    bool negative;
+    bool valid;
+};
+
+ShortestDecimal ShortestInInterval(double lo, double hi, bool inclusive);
+
+// char* output_end = ShortestInInterval(buffer, lo, hi, inclusive);
+//
+// Same as above, but converts the result into decimal form, using the same format as Dtoa.
+// Returns nullptr if the result is not valid.
+//
+// The buffer must be large enough, i.e. >= DtoaMinBufferLength.
+// The output is _not_ null-terminted.
+
+char* ShortestInInterval(char* buffer, double lo, double hi, bool inclusive);
+
 } // namespace ryu
@@ -0,0 +1,94 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cfloat>
+
+#include "ryu_64.h" // StrtodResult
+
+// The binary128 functions are only available if the compiler supports __float128 and
+// unsigned __int128 (e.g. GCC and Clang on x86-64).
+
+#ifndef SCHUBFACH_FLOAT128
+#if defined(__SIZEOF_FLOAT128__) && defined(__SIZEOF_INT128__)
+#define SCHUBFACH_FLOAT128 1
+#else
+#define SCHUBFACH_FLOAT128 0
+#endif
+#endif
+
+// The x87 extended precision functions are only available if, in addition, long double is the
+// 80-bit x87 format (e.g. GCC and Clang on x86-64 Linux).
+
+#ifndef SCHUBFACH_LONG_DOUBLE80
+#if SCHUBFACH_FLOAT128 && LDBL_MANT_DIG == 64 && LDBL_MAX_EXP == 16384
+#define SCHUBFACH_LONG_DOUBLE80 1
+#else
+#define SCHUBFACH_LONG_DOUBLE80 0
+#endif
+#endif
+
+#if SCHUBFACH_FLOAT128
+
+namespace schubfach {
+
+// char* output_end = Qtoa(buffer, value);
+//
+// Converts the given IEEE quadruple-precision (binary128) number into decimal form and stores the
+// result in the given buffer.
+//
+// The buffer must be large enough, i.e. >= QtoaMinBufferLength.
+// The output format is similar to printf("%g").
+// The output is _not_ null-terminted.
+//
+// The output is optimal, i.e. the output string
+//  1. rounds back to the input number when read in (using round-to-nearest-even)
+//  2. is as short as possible,
+//  3. is as close to the input number as possible.
+//
+// Note:
+// This function may temporarily write up to QtoaMinBufferLength characters into the buffer.
+
+constexpr int QtoaMinBufferLength = 64;
+
+char* Qtoa(char* buffer, __float128 value);
+
+// StrtodResult conversion_result = Strtoq(first, last, value);
+//
+// Converts the given decimal floating-point number into the nearest IEEE quadruple-precision
+// number (ties to even).
+// The function accepts the same inputs as ryu::Strtod. NaNs are converted into a quiet NaN.
+//
+// Note:
+// Inputs of any length are converted correctly. Inputs which are close to the midpoint between
+// two binary128 numbers are decided using (slow) bignum arithmetic.
+
+ryu::StrtodResult Strtoq(const char* next, const char* last, __float128& value);
+
+#if SCHUBFACH_LONG_DOUBLE80
+
+// char* output_end = LDtoa(buffer, value);
+//
+// Same as Qtoa, but for x87 extended precision numbers (64-bit significand with an explicit
+// integer bit). Unnormals, pseudo-infinities and pseudo-NaNs are printed as "nan".
+//
+// The buffer must be large enough, i.e. >= LDtoaMinBufferLength.
+
+constexpr int LDtoaMinBufferLength = 64;
+
+char* LDtoa(char* buffer, long double value);
+
+// StrtodResult conversion_result = StrtoLD(first, last, value);
+//
+// Same as Strtoq, but converts the input into the nearest x87 extended precision number.
+
+ryu::StrtodResult StrtoLD(const char* next, const char* last, long double& value);
+
+#endif // SCHUBFACH_LONG_DOUBLE80
+
+} // namespace schubfach
+
+#endif // SCHUBFACH_FLOAT128
@@ -0,0 +1,88 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ryu_64.h" // StrtodResult, TokenSpan
+
+namespace schubfach {
+
+// char* output_end = Htoa(buffer, value);
+// char* output_end = BF16toa(buffer, value);
+//
+// Converts the given IEEE half-precision (binary16) or bfloat16 number into decimal form and
+// stores the result in the given buffer. The number is passed as its bit pattern.
+//
+// The buffer must be large enough, i.e. >= HtoaMinBufferLength.
+// The output format is similar to printf("%g").
+// The output is _not_ null-terminted.
+//
+// The output is optimal, i.e. the output string
+//  1. rounds back to the input number when read in (using round-to-nearest-even)
+//  2. is as short as possible,
+//  3. is as close to the input number as possible.
+//
+// Note:
+// This function may temporarily write up to HtoaMinBufferLength characters into the buffer.
+
+constexpr int HtoaMinBufferLength = 32;
+
+char* Htoa(char* buffer, uint16_t value);
+char* BF16toa(char* buffer, uint16_t value);
+
+// char* output_end = HtoaTable(buffer, value);
+//
+// Same as Htoa, but copies the result from a precomputed table (about 230 KB), which is generated
+// at build time using Htoa. Only available if the library has been built with the CMake option
+// DRACHENNEST_HALF_TABLE, which defines SCHUBFACH_HALF_TABLE.
+//
+// Note:
+// Once the table is in the cache, this is much faster than Htoa. For occasional conversions, the
+// cache misses make it slower.
+
+#ifndef SCHUBFACH_HALF_TABLE
+#define SCHUBFACH_HALF_TABLE 0
+#endif
+
+#if SCHUBFACH_HALF_TABLE
+char* HtoaTable(char* buffer, uint16_t value);
+#endif
+
+// char* output_end = HtoaBatch(buffer, values, count, delimiter);
+// char* output_end = BF16toaBatch(buffer, values, count, delimiter);
+//
+// Converts count numbers as above and separates them by the given delimiter.
+// The buffer must be large enough, i.e. >= count * HtoaMinBufferLength.
+
+char* HtoaBatch(char* buffer, const uint16_t* values, size_t count, char delimiter);
+char* BF16toaBatch(char* buffer, const uint16_t* values, size_t count, char delimiter);
+
+// StrtodResult conversion_result = Strtoh(first, last, value);
+// StrtodResult conversion_result = StrtoBF16(first, last, value);
+//
+// Converts the given decimal floating-point number into the bit pattern of the nearest IEEE
+// half-precision (binary16) or bfloat16 number (ties to even).
+// The function accepts the same inputs as ryu::Strtod. NaNs are converted into a quiet NaN.
+//
+// Note:
+// The input is rounded directly into the target format, i.e. without double rounding.
+
+ryu::StrtodResult Strtoh(const char* next, const char* last, uint16_t& value);
+ryu::StrtodResult StrtoBF16(const char* next, const char* last, uint16_t& value);
+
+// size_t count = StrtohBatch(first, last, delimiter, values, max_values);
+// size_t count = StrtoBF16Batch(first, last, delimiter, values, max_values);
+//
+// Splits [first, last) into tokens, using ryu::ForEachToken, and converts each token as above.
+// Returns the number of tokens processed, which is at most max_values. Tokens which are not valid
+// numbers are converted into a quiet NaN.
+
+size_t StrtohBatch(const char* first, const char* last, char delimiter, uint16_t* values, size_t max_values);
+size_t StrtoBF16Batch(const char* first, const char* last, char delimiter, uint16_t* values, size_t max_values);
+
+} // namespace schubfach
@@ -20,6 +20,12 @@
 #if _MSC_VER
 #include <intrin.h>
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2() 1
+#include <emmintrin.h>
+#else
+#define HAS_SSE2() 0
+#endif
 
 #ifndef SF_ASSERT
 #define SF_ASSERT(X) assert(X)
@@ -698,3 +704,62 @@ char* schubfach::Ftoa(char* buffer, float value)
 {
     return ToChars(buffer, value);
 }
+
+static inline bool IsFloatExactImpl(double value)
+{
+    static constexpr double MaxFloat = static_cast<double>(std::numeric_limits<float>::max());
+
+    // NaNs and infinities are converted into the corresponding single-precision values.
+    const uint64_t bits = ReinterpretBits<uint64_t>(value);
+    const bool is_special = (bits & 0x7FF0000000000000) == 0x7FF0000000000000;
+
+    // Clamp finite numbers outside the range of float, so that the conversion is well-defined.
+    // (This does not change the result, since the clamped value is != value.)
+    const double clamped = value < -MaxFloat ? -MaxFloat : (value > MaxFloat ? MaxFloat : value);
+
+    return is_special || static_cast<double>(static_cast<float>(clamped)) == value;
+}
+
+bool schubfach::IsFloatExact(double value)
+{
+    return IsFloatExactImpl(value);
+}
+
+bool schubfach::AllFloatExact(const double* values, size_t count)
+{
+    size_t i = 0;
+
+#if HAS_SSE2()
+    for ( ; count - i >= 4; i += 4)
+    {
+        const __m128d x0 = _mm_loadu_pd(values + i);
+        const __m128d x1 = _mm_loadu_pd(values + i + 2);
+
+        // Finite numbers outside the range of float are converted into infinity (and compare
+        // not equal). NaNs compare not equal, too, and are handled by cmpunord.
+        const __m128d y0 = _mm_cvtps_pd(_mm_cvtpd_ps(x0));
+        const __m128d y1 = _mm_cvtps_pd(_mm_cvtpd_ps(x1));
+        const __m128d ok0 = _mm_or_pd(_mm_cmpeq_pd(x0, y0), _mm_cmpunord_pd(x0, x0));
+        const __m128d ok1 = _mm_or_pd(_mm_cmpeq_pd(x1, y1), _mm_cmpunord_pd(x1, x1));
+
+        if (_mm_movemask_pd(_mm_and_pd(ok0, ok1)) != 3)
+            return false;
+    }
+#endif
+
+    for ( ; i < count; ++i)
+    {
+        if (!IsFloatExactImpl(values[i]))
+            return false;
+    }
+
+    return true;
+}
+
+char* schubfach::DtoaAsFloat(char* buffer, double value)
+{
+    if (IsFloatExactImpl(value))
+        return ToChars(buffer, static_cast<float>(value));
+
+    return Dtoa(buffer, value);
+}
@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include "schubfach_64.h" // DtoaMinBufferLength
+
 namespace schubfach {
 
 // char* output_end = Ftoa(buffer, value);
@@ -28,4 +32,37 @@ constexpr int FtoaMinBufferLength = 32;
 
 char* Ftoa(char* buffer, float value);
 
+// bool exact = IsFloatExact(value);
+//
+// Returns whether the given double-precision number is exactly representable as a single-precision
+// number, i.e. whether static_cast<double>(static_cast<float>(value)) == value.
+// NaNs and infinities are considered exact.
+
+bool IsFloatExact(double value);
+
+// bool exact = AllFloatExact(values, count);
+//
+// Returns whether IsFloatExact(values[i]) holds for all 0 <= i < count.
+// This may be used to check whether a column of doubles actually contains single-precision data,
+// which may then be written (and read back) using the shorter single-precision representations.
+
+bool AllFloatExact(const double* values, size_t count);
+
+// char* output_end = DtoaAsFloat(buffer, value);
+//
+// Converts the given double-precision number into decimal form. If the number is exactly
+// representable as a single-precision number, the output is the same as for
+// Ftoa(buffer, static_cast<float>(value)), otherwise the output is the same as for
+// Dtoa(buffer, value). E.g.:
+//  DtoaAsFloat(buffer, static_cast<double>(0.1f)) == "0.1"
+//  Dtoa(buffer, static_cast<double>(0.1f)) == "0.10000000149011612"
+//
+// The output round-trips when read in as a float (in the first case) or as a double (in the
+// second case). Use AllFloatExact to check whether all values can be read in as floats.
+//
+// The buffer must be large enough, i.e. >= DtoaMinBufferLength.
+// The output is _not_ null-terminted.
+
+char* DtoaAsFloat(char* buffer, double value);
+
 } // namespace schubfach
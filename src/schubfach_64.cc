@@ -872,6 +872,21 @@ struct FloatingDecimal64 {
 };
 }
 
+using schubfach::ReaderTies;
+
+// Returns whether the lower boundary of the rounding interval rounds to v when read in.
+static constexpr bool AcceptLowerBoundary(ReaderTies ties, bool is_even)
+{
+    return ties == ReaderTies::to_even ? is_even : ties == ReaderTies::away_from_zero;
+}
+
+// Returns whether the upper boundary of the rounding interval rounds to v when read in.
+static constexpr bool AcceptUpperBoundary(ReaderTies ties, bool is_even)
+{
+    return ties == ReaderTies::to_even ? is_even : ties == ReaderTies::toward_zero;
+}
+
+template <ReaderTies Ties = ReaderTies::to_even>
 static inline FloatingDecimal64 ToDecimal64(uint64_t ieee_significand, uint64_t ieee_exponent)
 {
     uint64_t c;
@@ -893,8 +908,8 @@ static inline FloatingDecimal64 ToDecimal64(uint64_t ieee_significand, uint64_t
     }
 
     const bool is_even = (c % 2 == 0);
-    const bool accept_lower = is_even;
-    const bool accept_upper = is_even;
+    const bool accept_lower = AcceptLowerBoundary(Ties, is_even);
+    const bool accept_upper = AcceptUpperBoundary(Ties, is_even);
 
     const bool lower_boundary_is_closer = (ieee_significand == 0 && ieee_exponent > 1);
 
@@ -1300,6 +1315,7 @@ static inline char* FormatDigits(char* buffer, uint64_t digits, int32_t decimal_
     return buffer;
 }
 
+template <ReaderTies Ties = ReaderTies::to_even>
 static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_zero = false)
 {
     const Double v(value);
@@ -1318,7 +1334,7 @@ static inline char* ToChars(char* buffer, double value, bool force_trailing_dot_
         {
             // != 0
 
-            const auto dec = ToDecimal64(significand, exponent);
+            const auto dec = ToDecimal64<Ties>(significand, exponent);
             return FormatDigits(buffer, dec.digits, dec.exponent, force_trailing_dot_zero);
         }
         else
@@ -1352,3 +1368,565 @@ char* schubfach::Dtoa(char* buffer, double value)
 {
     return ToChars(buffer, value);
 }
+
+template <ReaderTies Ties>
+char* schubfach::Dtoa(char* buffer, double value)
+{
+    return ToChars<Ties>(buffer, value);
+}
+
+template char* schubfach::Dtoa<ReaderTies::to_even>(char* buffer, double value);
+template char* schubfach::Dtoa<ReaderTies::away_from_zero>(char* buffer, double value);
+template char* schubfach::Dtoa<ReaderTies::toward_zero>(char* buffer, double value);
+template char* schubfach::Dtoa<ReaderTies::unknown>(char* buffer, double value);
+
+//==================================================================================================
+// DtoaDigits
+//==================================================================================================
+
+// Converts the number 0 <= n < 10^8 into 8 decimal digits, using SWAR arithmetic.
+// The i-th byte (counting from the least significant byte) of the result contains the i-th digit
+// (counting from the most significant digit).
+static inline uint64_t Utoa_8Digits_SWAR(uint32_t n)
+{
+    SF_ASSERT(n < 100000000);
+
+    // 2 x 4 digits
+    const uint32_t hi4 = n / 10000;
+    const uint32_t lo4 = n % 10000;
+    uint64_t x = uint64_t{hi4} | uint64_t{lo4} << 32;
+
+    // 4 x 2 digits: floor(x / 100) = floor(x * 5243 / 2^19) for x < 10^4
+    const uint64_t q2 = ((x * 5243) >> 19) & 0x0000007F0000007Full;
+    x = q2 | (x - 100 * q2) << 16;
+
+    // 8 x 1 digit: floor(x / 10) = floor(x * 103 / 2^10) for x < 100
+    const uint64_t q1 = ((x * 103) >> 10) & 0x000F000F000F000Full;
+    x = q1 | (x - 10 * q1) << 8;
+
+    return x;
+}
+
+// Packs 8 digits, as returned by Utoa_8Digits_SWAR, into 4 bytes of packed BCD.
+static inline uint32_t PackBCD_8Digits(uint64_t x)
+{
+    x = ((x << 4) | (x >> 8)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+    return static_cast<uint32_t>(x);
+}
+
+static inline void StoreBytes(uint8_t* buf, uint64_t x, int32_t n)
+{
+    for (int32_t i = 0; i < n; ++i)
+    {
+        buf[i] = static_cast<uint8_t>(x >> (8 * i));
+    }
+}
+
+// Splits the 17-digit number d = d[0]d[1]...d[16] into d[0], d[1...8] and d[9...16], the same way
+// as PrintDecimalDigitsBackwards does.
+static inline void Utoa_17Digits_SWAR(uint64_t d, uint64_t& d0, uint64_t& d1_8, uint64_t& d9_16)
+{
+    SF_ASSERT(d <= 99999999999999999ull);
+
+    const uint64_t q = d / 100000000;
+    const uint32_t r = static_cast<uint32_t>(d % 100000000);
+
+    d0    = q / 100000000;
+    d1_8  = Utoa_8Digits_SWAR(static_cast<uint32_t>(q % 100000000));
+    d9_16 = Utoa_8Digits_SWAR(r);
+}
+
+// Returns the shortest representation of the finite number value, with trailing zeros removed.
+// Zero is returned as {0, 0}.
+static inline FloatingDecimal64 ToDecimalDigits(const Double v)
+{
+    const uint64_t significand = v.PhysicalSignificand();
+    const uint64_t exponent = v.PhysicalExponent();
+    SF_ASSERT(exponent != Double::MaxIeeeExponent);
+
+    if (exponent == 0 && significand == 0)
+        return {0, 0};
+
+    auto dec = ToDecimal64(significand, exponent);
+    SF_ASSERT(dec.digits != 0);
+
+    while (dec.digits % 10 == 0)
+    {
+        dec.digits /= 10;
+        dec.exponent += 1;
+    }
+
+    return dec;
+}
+
+schubfach::DecimalDigits schubfach::DtoaDigits(uint8_t* digits, double value)
+{
+    const Double v(value);
+
+    if (!v.IsFinite())
+        return {0, 0, v.SignBit()};
+
+    const auto dec = ToDecimalDigits(v);
+
+    uint64_t d0;
+    uint64_t d1_8;
+    uint64_t d9_16;
+    Utoa_17Digits_SWAR(dec.digits, d0, d1_8, d9_16);
+
+    // Write all 17 digits (right-aligned) and then copy the significant digits.
+    const int32_t num_digits = dec.digits == 0 ? 1 : DecimalLength(dec.digits);
+    const int32_t skip = 17 - num_digits;
+
+    uint8_t tmp[17];
+    tmp[0] = static_cast<uint8_t>(d0);
+    StoreBytes(tmp + 1, d1_8, 8);
+    StoreBytes(tmp + 9, d9_16, 8);
+    std::memcpy(digits, tmp + skip, static_cast<size_t>(num_digits));
+
+    return {num_digits, dec.exponent, v.SignBit()};
+}
+
+schubfach::DecimalDigits schubfach::DtoaPackedBCD(uint8_t* bcd, double value)
+{
+    const Double v(value);
+
+    if (!v.IsFinite())
+        return {0, 0, v.SignBit()};
+
+    const auto dec = ToDecimalDigits(v);
+
+    uint64_t d0;
+    uint64_t d1_8;
+    uint64_t d9_16;
+    Utoa_17Digits_SWAR(dec.digits, d0, d1_8, d9_16);
+
+    // Nibbles: d[0] d[1] ... d[16] sign
+    // Re-align the digits to pairs {d[0], d[1]}, {d[2], d[3]}, ..., {d[16], sign}.
+    const uint64_t d0_7  = d0 | d1_8 << 8;
+    const uint64_t d8_15 = d1_8 >> 56 | d9_16 << 8;
+    const uint32_t d16   = static_cast<uint32_t>(d9_16 >> 56);
+    const uint32_t sign  = v.SignBit() ? 0xD : 0xC;
+
+    StoreBytes(bcd + 0, PackBCD_8Digits(d0_7), 4);
+    StoreBytes(bcd + 4, PackBCD_8Digits(d8_15), 4);
+    bcd[8] = static_cast<uint8_t>(d16 << 4 | sign);
+
+    const int32_t num_digits = dec.digits == 0 ? 1 : DecimalLength(dec.digits);
+
+    return {num_digits, dec.exponent, v.SignBit()};
+}
+
+//==================================================================================================
+// DtoaShortestMaxDigits
+//==================================================================================================
+
+static inline uint64_t SmallPow10(int32_t e10)
+{
+    static constexpr uint64_t Pow10Table[] = {
+        1,
+        10,
+        100,
+        1000,
+        10000,
+        100000,
+        1000000,
+        10000000,
+        100000000,
+        1000000000,
+        10000000000,
+        100000000000,
+        1000000000000,
+        10000000000000,
+        100000000000000,
+        1000000000000000,
+        10000000000000000,
+    };
+
+    SF_ASSERT(e10 >= 0);
+    SF_ASSERT(e10 <= 16);
+    return Pow10Table[static_cast<uint32_t>(e10)];
+}
+
+// Returns v = c * 2^q correctly rounded (ties to even) to max_digits significant decimal digits.
+// The shortest representation of v must have more than max_digits significant digits.
+static inline FloatingDecimal64 ToDecimal64Rounded(uint64_t ieee_significand, uint64_t ieee_exponent, int32_t max_digits)
+{
+    uint64_t c;
+    int32_t q;
+    if (ieee_exponent != 0)
+    {
+        c = Double::HiddenBit | ieee_significand;
+        q = static_cast<int32_t>(ieee_exponent) - Double::ExponentBias;
+    }
+    else
+    {
+        c = ieee_significand;
+        q = 1 - Double::ExponentBias;
+    }
+
+    // Compute vb = 4 * v * 10^-k (rounded to odd), just like ToDecimal64 does.
+    // The shortest representation of v is a multiple of 10^k (or of 10^(k+1), or of 10^(k-1) if
+    // the lower boundary is closer), so s = floor(v * 10^-k) has at least (one less) as many
+    // digits as the shortest representation.
+    SF_ASSERT(q >= -1500);
+    SF_ASSERT(q <=  1500);
+    const int32_t k = FloorDivPow2(q * 1262611, 22);
+
+    const int32_t h = q + FloorLog2Pow10(-k) + 1;
+    SF_ASSERT(h >= 1);
+    SF_ASSERT(h <= 4);
+
+    const uint64x2 pow10 = ComputePow10_Double(-k);
+    const uint64_t vb = RoundToOdd(pow10, (4 * c) << h);
+
+    // Remove the last r digits from s = vb / 4 and round.
+    // NB: Since vb is rounded to odd, comparing vb with the even number 2 * 10^r is exact.
+    const int32_t r = DecimalLength(vb / 4) - max_digits;
+    SF_ASSERT(r >= 0);
+
+    const uint64_t p = 4 * SmallPow10(r);
+    const uint64_t i = vb / p;
+    const uint64_t f = vb % p;
+    const uint64_t half = p / 2;
+
+    const bool round_up = f > half || (f == half && i % 2 != 0);
+
+    return {i + round_up, k + r};
+}
+
+char* schubfach::DtoaShortestMaxDigits(char* buffer, double value, int max_digits)
+{
+    const Double v(value);
+
+    if (!v.IsFinite() || v.IsZero() || max_digits >= 17)
+    {
+        return ToChars(buffer, value);
+    }
+
+    const int32_t n = max_digits < 1 ? 1 : max_digits;
+
+    auto dec = ToDecimalDigits(v);
+    if (DecimalLength(dec.digits) > n)
+    {
+        dec = ToDecimal64Rounded(v.PhysicalSignificand(), v.PhysicalExponent(), n);
+    }
+
+    buffer[0] = '-';
+    buffer += v.SignBit();
+
+    return FormatDigits(buffer, dec.digits, dec.exponent);
+}
+
+//==================================================================================================
+// DtoaFitWidth
+//==================================================================================================
+
+// Returns v rounded to (at most) max_digits significant digits, with trailing zeros removed.
+static inline FloatingDecimal64 ToDecimalDigitsRounded(const Double v, const FloatingDecimal64 shortest, int32_t max_digits)
+{
+    if (DecimalLength(shortest.digits) <= max_digits)
+        return shortest;
+
+    auto dec = ToDecimal64Rounded(v.PhysicalSignificand(), v.PhysicalExponent(), max_digits);
+    while (dec.digits % 10 == 0)
+    {
+        dec.digits /= 10;
+        dec.exponent += 1;
+    }
+
+    return dec;
+}
+
+// Returns the length of the fixed-point representation of num_digits digits, where the decimal
+// point is at position decimal_point, i.e. "0.000ddd", "ddd.ddd" or "ddd000".
+static inline int32_t FixedLength(int32_t num_digits, int32_t decimal_point, bool fortran_style)
+{
+    if (decimal_point <= 0)
+        return 2 - decimal_point + num_digits;
+    if (decimal_point < num_digits)
+        return num_digits + 1;
+    return decimal_point + (fortran_style ? 1 : 0);
+}
+
+// Returns the length of the scientific representation of num_digits digits, where the decimal
+// point is at position decimal_point, i.e. "d.ddde-X" or "d.ddd-X".
+static inline int32_t ScientificLength(int32_t num_digits, int32_t decimal_point, bool fortran_style)
+{
+    const int32_t x = decimal_point - 1;
+    const int32_t abs_x = x < 0 ? -x : x;
+    const int32_t exponent_length = abs_x >= 100 ? 3 : (abs_x >= 10 ? 2 : 1);
+
+    if (fortran_style)
+        return num_digits + 1 + 1 + exponent_length;
+
+    return num_digits + (num_digits > 1 ? 1 : 0) + 1 + (x < 0 ? 1 : 0) + exponent_length;
+}
+
+static inline char* FormatFixed(char* buffer, const char* digits, int32_t num_digits, int32_t decimal_point, bool fortran_style)
+{
+    if (decimal_point <= 0)
+    {
+        buffer[0] = '0';
+        buffer[1] = '.';
+        buffer += 2;
+        std::memset(buffer, '0', static_cast<size_t>(-decimal_point));
+        buffer += -decimal_point;
+        std::memcpy(buffer, digits, static_cast<size_t>(num_digits));
+        return buffer + num_digits;
+    }
+
+    if (decimal_point < num_digits)
+    {
+        std::memcpy(buffer, digits, static_cast<size_t>(decimal_point));
+        buffer += decimal_point;
+        buffer[0] = '.';
+        buffer += 1;
+        std::memcpy(buffer, digits + decimal_point, static_cast<size_t>(num_digits - decimal_point));
+        return buffer + (num_digits - decimal_point);
+    }
+
+    std::memcpy(buffer, digits, static_cast<size_t>(num_digits));
+    buffer += num_digits;
+    std::memset(buffer, '0', static_cast<size_t>(decimal_point - num_digits));
+    buffer += decimal_point - num_digits;
+    if (fortran_style)
+    {
+        buffer[0] = '.';
+        buffer += 1;
+    }
+    return buffer;
+}
+
+static inline char* FormatScientific(char* buffer, const char* digits, int32_t num_digits, int32_t decimal_point, bool fortran_style)
+{
+    buffer[0] = digits[0];
+    buffer += 1;
+    if (num_digits > 1 || fortran_style)
+    {
+        buffer[0] = '.';
+        buffer += 1;
+        std::memcpy(buffer, digits + 1, static_cast<size_t>(num_digits - 1));
+        buffer += num_digits - 1;
+    }
+
+    const int32_t x = decimal_point - 1;
+    const uint32_t abs_x = static_cast<uint32_t>(x < 0 ? -x : x);
+
+    if (!fortran_style)
+    {
+        buffer[0] = 'e';
+        buffer += 1;
+    }
+    if (x < 0 || fortran_style)
+    {
+        buffer[0] = x < 0 ? '-' : '+';
+        buffer += 1;
+    }
+
+    if (abs_x >= 100)
+    {
+        buffer[0] = static_cast<char>('0' + abs_x / 100);
+        buffer[1] = static_cast<char>('0' + abs_x / 10 % 10);
+        buffer[2] = static_cast<char>('0' + abs_x % 10);
+        return buffer + 3;
+    }
+    if (abs_x >= 10)
+    {
+        buffer[0] = static_cast<char>('0' + abs_x / 10);
+        buffer[1] = static_cast<char>('0' + abs_x % 10);
+        return buffer + 2;
+    }
+    buffer[0] = static_cast<char>('0' + abs_x);
+    return buffer + 1;
+}
+
+char* schubfach::DtoaFitWidth(char* buffer, double value, int width, bool fortran_style)
+{
+    const Double v(value);
+    const int32_t sign = v.SignBit() ? 1 : 0;
+
+    if (!v.IsFinite() || v.IsZero())
+    {
+        char tmp[DtoaMinBufferLength];
+        char* end = ToChars(tmp, value);
+        if (fortran_style && v.IsZero())
+        {
+            // "0." or "-0."
+            end[0] = '.';
+            end += 1;
+        }
+
+        const int32_t length = static_cast<int32_t>(end - tmp);
+        if (length > width)
+            return nullptr;
+
+        std::memcpy(buffer, tmp, static_cast<size_t>(length));
+        return buffer + length;
+    }
+
+    const FloatingDecimal64 shortest = ToDecimalDigits(v);
+    const int32_t shortest_digits = DecimalLength(shortest.digits);
+    const int32_t shortest_point = shortest_digits + shortest.exponent;
+
+    // Try all precisions, starting with the shortest representation, until the output fits.
+    for (int32_t precision = shortest_digits; precision >= 1; --precision)
+    {
+        // Skip precisions which definitely do not fit, without rounding.
+        // Rounding may move the decimal point by one digit to the left (e.g. 9.99 -> 10.0), or
+        // may produce trailing zeros. In the latter case the rounded number is the same as for a
+        // smaller precision, which is tried later.
+        if (precision > 1)
+        {
+            const bool may_fit = sign + FixedLength(precision, shortest_point, fortran_style) <= width
+                              || sign + FixedLength(precision, shortest_point + 1, fortran_style) <= width
+                              || sign + ScientificLength(precision, shortest_point, fortran_style) <= width
+                              || sign + ScientificLength(precision, shortest_point + 1, fortran_style) <= width;
+            if (!may_fit)
+                continue;
+        }
+
+        const FloatingDecimal64 dec = ToDecimalDigitsRounded(v, shortest, precision);
+
+        const int32_t num_digits = DecimalLength(dec.digits);
+        const int32_t decimal_point = num_digits + dec.exponent;
+
+        char digits[17];
+        uint64_t d = dec.digits;
+        for (int32_t i = num_digits - 1; i >= 0; --i)
+        {
+            digits[i] = static_cast<char>('0' + d % 10);
+            d /= 10;
+        }
+
+        if (sign + FixedLength(num_digits, decimal_point, fortran_style) <= width)
+        {
+            buffer[0] = '-';
+            return FormatFixed(buffer + sign, digits, num_digits, decimal_point, fortran_style);
+        }
+        if (sign + ScientificLength(num_digits, decimal_point, fortran_style) <= width)
+        {
+            buffer[0] = '-';
+            return FormatScientific(buffer + sign, digits, num_digits, decimal_point, fortran_style);
+        }
+    }
+
+    return nullptr;
+}
+
+//==================================================================================================
+// DtoaFloor / DtoaCeil
+//==================================================================================================
+
+// Returns the shortest decimal number in [v^-, v] (if !away_from_zero) or in [v, v^+] (if
+// away_from_zero), where v = c * 2^q is the (positive) input number and v^- and v^+ are its
+// predecessor and successor. (For the maximum double, v^+ = 2^1024.)
+// If there are several such numbers, the one closest to v is returned.
+// The result may be 0 (only if v is the minimum subnormal number and !away_from_zero).
+//
+// The interval has the same length as the rounding interval of v (or half the length, if v is a
+// power of 2 and the lower boundary is closer), so the same k as in ToDecimal64 may be used: The
+// interval contains at least one multiple of 10^k and at most one multiple of 10^(k+1).
+static inline FloatingDecimal64 ToDecimal64Directed(uint64_t ieee_significand, uint64_t ieee_exponent, bool away_from_zero)
+{
+    uint64_t c;
+    int32_t q;
+    if (ieee_exponent != 0)
+    {
+        c = Double::HiddenBit | ieee_significand;
+        q = static_cast<int32_t>(ieee_exponent) - Double::ExponentBias;
+    }
+    else
+    {
+        c = ieee_significand;
+        q = 1 - Double::ExponentBias;
+    }
+
+    if (!away_from_zero && ieee_significand == 0 && ieee_exponent > 1)
+    {
+        // The predecessor of v = 2^52 * 2^q is (2^53 - 1) * 2^(q-1).
+        // Write v as 2^53 * 2^(q-1), so that the interval is [c - 1, c] * 2^q again.
+        c = 2 * c;
+        q = q - 1;
+    }
+
+    const uint64_t cbl = away_from_zero ? 4 * c : 4 * c - 4;
+    const uint64_t cbr = away_from_zero ? 4 * c + 4 : 4 * c;
+
+    SF_ASSERT(q >= -1500);
+    SF_ASSERT(q <=  1500);
+    const int32_t k = FloorDivPow2(q * 1262611, 22);
+
+    const int32_t h = q + FloorLog2Pow10(-k) + 1;
+    SF_ASSERT(h >= 1);
+    SF_ASSERT(h <= 4);
+
+    // NB: vbl and vbr are rounded to odd, so comparing them with multiples of 4 is exact, and
+    // floor(vbr / 4) and ceil(vbl / 4) are the multiples of 10^k just inside the interval.
+    const uint64x2 pow10 = ComputePow10_Double(-k);
+    const uint64_t vbl = RoundToOdd(pow10, cbl << h);
+    const uint64_t vbr = RoundToOdd(pow10, cbr << h);
+
+    if (away_from_zero)
+    {
+        // Choose the smallest candidate, i.e. the one closest to v.
+        const uint64_t sp = (vbl + 39) / 40;
+        if (40 * sp <= vbr)
+            return {sp, k + 1};
+
+        const uint64_t s = (vbl + 3) / 4;
+        SF_ASSERT(4 * s <= vbr);
+        return {s, k};
+    }
+    else
+    {
+        // Choose the largest candidate, i.e. the one closest to v.
+        const uint64_t sp = vbr / 40;
+        if (vbl <= 40 * sp)
+            return {sp, k + 1};
+
+        const uint64_t s = vbr / 4;
+        SF_ASSERT(vbl <= 4 * s);
+        return {s, k};
+    }
+}
+
+static inline char* ToCharsDirected(char* buffer, double value, bool upward)
+{
+    const Double v(value);
+
+    const uint64_t significand = v.PhysicalSignificand();
+    const uint64_t exponent = v.PhysicalExponent();
+
+    if (exponent == Double::MaxIeeeExponent || (exponent == 0 && significand == 0))
+    {
+        // +-0, or Infinity, or NaN
+        return ToChars(buffer, value);
+    }
+
+    buffer[0] = '-';
+    buffer += v.SignBit();
+
+    // Rounding toward +Infinity increases the magnitude of positive numbers and decreases the
+    // magnitude of negative numbers.
+    const bool away_from_zero = (upward != v.SignBit());
+    const FloatingDecimal64 dec = ToDecimal64Directed(significand, exponent, away_from_zero);
+    if (dec.digits == 0)
+    {
+        buffer[0] = '0';
+        return buffer + 1;
+    }
+
+    return FormatDigits(buffer, dec.digits, dec.exponent);
+}
+
+char* schubfach::DtoaFloor(char* buffer, double value)
+{
+    return ToCharsDirected(buffer, value, /*upward*/ false);
+}
+
+char* schubfach::DtoaCeil(char* buffer, double value)
+{
+    return ToCharsDirected(buffer, value, /*upward*/ true);
+}
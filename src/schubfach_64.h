@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace schubfach {
 
 // char* output_end = Dtoa(buffer, value);
@@ -28,4 +30,115 @@ constexpr int DtoaMinBufferLength = 64;
 
 char* Dtoa(char* buffer, double value);
 
+// char* output_end = Dtoa<ReaderTies::away_from_zero>(buffer, value);
+//
+// Same as above, but the output is optimal for readers which break ties using the given rule,
+// i.e. the output string rounds back to the input number when read in using the given rule, and
+// is as short as possible (and as close to the input number as possible) under this constraint.
+//
+// Dtoa<ReaderTies::to_even> is equivalent to Dtoa.
+// Dtoa<ReaderTies::unknown> produces output which rounds back to the input number regardless of
+// how the reader breaks ties (like Grisu2, but always as short as possible).
+
+enum class ReaderTies {
+    to_even,        // Round-half-to-even
+    away_from_zero, // Round-half-away-from-zero
+    toward_zero,    // Round-half-toward-zero
+    unknown,        // Round-half-to-whatever
+};
+
+template <ReaderTies Ties>
+char* Dtoa(char* buffer, double value);
+
+// DecimalDigits dec = DtoaDigits(digits, value);
+//
+// Same as Dtoa, but instead of formatting the result as text, stores the significant digits of the
+// shortest representation as an array of values in [0, 9] (most significant digit first, trailing
+// zeros removed) in the given buffer, such that |value| = digits * 10^dec.exponent.
+//
+// The buffer must be large enough, i.e. >= DtoaDigitsMinBufferLength.
+// If value is not finite, dec.num_digits is 0 and the buffer is not modified.
+// For +-0, a single digit 0 (with exponent 0) is stored.
+
+struct DecimalDigits
+{
+    int32_t num_digits; // In [1, 17], or 0 if the value is not finite.
+    int32_t exponent;
+    bool    negative;   // The sign bit of the value.
+};
+
+constexpr int DtoaDigitsMinBufferLength = 17;
+
+DecimalDigits DtoaDigits(uint8_t* digits, double value);
+
+// DecimalDigits dec = DtoaPackedBCD(bcd, value);
+//
+// Same as above, but stores the digits as packed BCD (COMP-3, PIC S9(17)) into exactly
+// DtoaPackedBCDLength bytes: 17 digits, right-aligned and padded with leading zeros, followed by a
+// sign nibble (0xC for positive numbers, 0xD for negative numbers). Two digits per byte, most
+// significant nibble first.
+// If value is not finite, dec.num_digits is 0 and the buffer is not modified.
+
+constexpr int DtoaPackedBCDLength = 9;
+
+DecimalDigits DtoaPackedBCD(uint8_t* bcd, double value);
+
+// char* output_end = DtoaShortestMaxDigits(buffer, value, max_digits);
+//
+// Same as Dtoa, but the output has at most max_digits significant digits: If the shortest
+// representation has at most max_digits digits, the output is the same as Dtoa. Otherwise, the
+// exact value is correctly rounded (ties to even) to max_digits digits, like printf("%.*e") would
+// do, and trailing zeros are removed. In this case the output does not necessarily round back to
+// the input number.
+//
+// max_digits < 1 is treated as 1. For max_digits >= 17 the output is the same as Dtoa.
+// The buffer must be large enough, i.e. >= DtoaMinBufferLength.
+//
+// Note:
+// The digits are computed with the same 128-bit arithmetic as Dtoa, i.e. no bignum arithmetic is
+// required.
+
+char* DtoaShortestMaxDigits(char* buffer, double value, int max_digits);
+
+// char* output_end = DtoaFitWidth(buffer, value, width, fortran_style);
+//
+// Converts the given double-precision number into the most precise decimal representation, which
+// has at most width characters (including the sign). The output has as many significant digits as
+// possible (but not more than the shortest representation), and is correctly rounded (ties to even)
+// from the exact value of the input.
+//
+// The number is formatted either in fixed-point notation (e.g. "-0.00123", "123.45", "12300") or,
+// if this is too long, in scientific notation with a minimal exponent (e.g. "1.23e-5", "1.2e10").
+// If fortran_style is true, the 'e' is omitted and the exponent always has a sign, and the number
+// always has a decimal point (e.g. "1.23-5", "1.+10", "12300."), as in NASTRAN fields.
+//
+// Returns nullptr if not even a single significant digit fits into the given width. In this case
+// the buffer is not modified. Zero, infinity and NaN are formatted as in Dtoa, except that zero
+// is formatted as "0." or "-0." if fortran_style is true.
+// The buffer must be large enough, i.e. >= width.
+// The output is _not_ null-terminted.
+
+char* DtoaFitWidth(char* buffer, double value, int width, bool fortran_style = false);
+
+// char* output_end = DtoaFloor(buffer, value);
+// char* output_end = DtoaCeil(buffer, value);
+//
+// Same as Dtoa, but the output is guaranteed to be <= value (DtoaFloor), resp. >= value (DtoaCeil),
+// e.g. for printing the bounds of intervals. The output is the shortest decimal number in
+// [pred(value), value], resp. [value, succ(value)], where pred and succ are the adjacent double-
+// precision numbers. If there are several such numbers, the one closest to value is chosen.
+//
+// When read in (using round-to-nearest-even), the output of DtoaFloor converts into value or its
+// predecessor, and the output of DtoaCeil converts into value or its successor. The output has at
+// most 17 significant digits.
+// E.g.: DtoaFloor(0.1) = "0.1", DtoaCeil(0.1) = "0.10000000000000001"
+//       DtoaFloor(1.0 / 3.0) = "0.3333333333333333", DtoaCeil(1.0 / 3.0) = "0.33333333333333332"
+//
+// Zero, infinity and NaN are formatted as in Dtoa. DtoaFloor(denorm_min) is "0".
+// The buffer must be large enough, i.e. >= DtoaMinBufferLength.
+// The output is _not_ null-terminted.
+
+char* DtoaFloor(char* buffer, double value);
+char* DtoaCeil(char* buffer, double value);
+
 } // namespace schubfach
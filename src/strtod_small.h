@@ -0,0 +1,202 @@
+// Copyright 2020 Alexander Bolz
+//
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+//--------------------------------------------------------------------------------------------------
+// Conversion of decimal strings into binary floating-point formats with at most 16 bits, i.e.
+// formats in which all numbers and all midpoints between adjacent numbers are doubles.
+//
+// Used by schubfach_16.cc (binary16, bfloat16) and fp8.cc (E4M3, E5M2). Not part of the public
+// interface.
+//
+// The Format parameter must provide:
+//
+//     using bits_type = ...;           // uint16_t or uint8_t
+//     SignificandSize                  // = p   (includes the hidden bit)
+//     ExponentBias                     // = bias + (p - 1)
+//     SignMask
+//     MaxFinite                        // bits of the largest finite number
+//     Overflow                         // bits of the result for numbers larger than MaxFinite
+//     NaN                              // bits of the result for NaNs and invalid tokens
+//--------------------------------------------------------------------------------------------------
+
+#include "ryu_64.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifndef STRTOD_SMALL_ASSERT
+#define STRTOD_SMALL_ASSERT(X) assert(X)
+#endif
+
+namespace strtod_small {
+
+template <typename Dest, typename Source>
+inline Dest ReinterpretBits(Source source)
+{
+    static_assert(sizeof(Dest) == sizeof(Source), "size mismatch");
+
+    Dest dest;
+    std::memcpy(&dest, &source, sizeof(Source));
+    return dest;
+}
+
+inline int32_t FloorLog2(uint64_t x)
+{
+    STRTOD_SMALL_ASSERT(x != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return static_cast<int32_t>(index);
+#else
+    int32_t l2 = 0;
+    for (;;)
+    {
+        x >>= 1;
+        if (x == 0)
+            break;
+        ++l2;
+    }
+    return l2;
+#endif
+}
+
+// Rounds x = v + epsilon to the nearest number in the given format (ties to even), where v >= 0 is
+// a double and 0 <= epsilon < ulp(v). is_inexact() must return whether epsilon > 0; it is only
+// called if x might be a tie.
+// Returns the bits of the result, or Format::Overflow if the result is larger than the largest
+// finite number.
+template <typename Format, typename IsInexact>
+inline typename Format::bits_type RoundDouble(double v, IsInexact is_inexact)
+{
+    using bits_type = typename Format::bits_type;
+
+    const uint64_t bits = ReinterpretBits<uint64_t>(v);
+    const uint64_t F = bits & 0x000FFFFFFFFFFFFFull;
+    const uint64_t E = bits >> 52;
+    STRTOD_SMALL_ASSERT(E <= 0x7FF);
+
+    if (E == 0x7FF)
+        return Format::Overflow;
+    if (E == 0 && F == 0)
+        return 0; // x < denorm_min(double)
+
+    const uint64_t m2 = (E == 0) ? F : (F | 0x0010000000000000ull);
+    const int32_t  e2 = (E == 0 ? 1 : static_cast<int32_t>(E)) - 1075;
+
+    // The exponent of the result is q >= MinExponent, such that the result is r * 2^q
+    // with 0 <= r < 2^p.
+    static constexpr int32_t MinExponent = 1 - Format::ExponentBias;
+    int32_t q = e2 + FloorLog2(m2) - (Format::SignificandSize - 1);
+    if (q < MinExponent)
+        q = MinExponent;
+
+    const int32_t s = q - e2;
+    STRTOD_SMALL_ASSERT(s >= 53 - Format::SignificandSize);
+    if (s >= 54)
+        return 0; // x < 2^(e2 + 53) <= 2^(q - 1)
+
+    const uint64_t half = uint64_t{1} << (s - 1);
+    const uint64_t rem  = m2 & (2 * half - 1);
+    uint64_t r = m2 >> s;
+
+    const bool round_up = rem > half || (rem == half && ((r & 1) != 0 || is_inexact()));
+    r += round_up;
+    if (r >> Format::SignificandSize) // r == 2^p
+    {
+        r >>= 1;
+        ++q;
+    }
+
+    static constexpr uint64_t HiddenBit = uint64_t{1} << (Format::SignificandSize - 1);
+    if (r < HiddenBit)
+        return static_cast<bits_type>(r); // subnormal (or zero)
+
+    const uint64_t biased_exponent = static_cast<uint64_t>(q - MinExponent + 1);
+    const uint64_t result = biased_exponent << (Format::SignificandSize - 1) | (r & (HiddenBit - 1));
+    if (result > Format::MaxFinite)
+        return Format::Overflow;
+
+    return static_cast<bits_type>(result);
+}
+
+// Converts the decimal number in [next, last) into the nearest number in the given format (ties to
+// even). If saturate is true, numbers which are too large (including infinities) are converted into
+// the largest finite number.
+template <typename Format>
+inline ryu::StrtodResult Strtod(const char* next, const char* last, typename Format::bits_type& value, bool saturate)
+{
+    using bits_type = typename Format::bits_type;
+
+    // Truncate the input to double-precision first. The exact input then lies in
+    // [truncated, succ(truncated)), and since all numbers in the target format and all midpoints
+    // between them are doubles, this is sufficient to round correctly.
+    double truncated;
+    const auto res = ryu::Strtod(next, last, truncated, ryu::RoundingMode::toward_zero);
+    if (!res)
+        return res;
+
+    if (res.status == ryu::StrtodStatus::nan)
+    {
+        value = Format::NaN;
+        return res;
+    }
+
+    const bool is_negative = (ReinterpretBits<uint64_t>(truncated) >> 63) != 0;
+
+    bits_type magnitude = RoundDouble<Format>(is_negative ? -truncated : truncated, [&] {
+        double away;
+        ryu::Strtod(next, last, away, is_negative ? ryu::RoundingMode::downward : ryu::RoundingMode::upward);
+        return away != truncated;
+    });
+
+    if (magnitude == Format::Overflow && saturate)
+        magnitude = Format::MaxFinite;
+
+    value = static_cast<bits_type>((is_negative ? Format::SignMask : 0) | magnitude);
+    return res;
+}
+
+// Splits [first, last) into tokens, using ryu::ForEachToken, and converts each token as above.
+// Returns the number of tokens processed, which is at most max_values. Tokens which are not valid
+// numbers are converted into Format::NaN.
+template <typename Format>
+inline size_t StrtodBatch(const char* first, const char* last, char delimiter, typename Format::bits_type* values, size_t max_values, bool saturate)
+{
+    using bits_type = typename Format::bits_type;
+
+    struct Context
+    {
+        bits_type* values;
+        size_t max_values;
+        size_t count;
+        bool saturate;
+    };
+
+    Context context{values, max_values, 0, saturate};
+    ryu::ForEachToken(first, last, delimiter, [](void* ctx, const char* token_first, const char* token_last) {
+        auto& c = *static_cast<Context*>(ctx);
+        if (c.count == c.max_values)
+            return false;
+
+        bits_type value;
+        const auto res = Strtod<Format>(token_first, token_last, value, c.saturate);
+        c.values[c.count++] = (!res || res.next != token_last) ? Format::NaN : value;
+        return true;
+    }, &context);
+
+    return context.count;
+}
+
+} // namespace strtod_small
@@ -2,25 +2,34 @@
 
 #include "double-conversion/double-conversion.h"
 
+#include "dragon4.h"
+#include "fp8.h"
 #include "grisu2.h"
 #include "grisu2b.h"
 #include "grisu3.h"
 #include "ryu_32.h"
 #include "ryu_64.h"
+#include "schubfach_16.h"
 #include "schubfach_32.h"
 #include "schubfach_64.h"
+#include "schubfach_128.h"
 #include "dragonbox.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <string>
+#include <vector>
 #include <cmath>
 
 #include "scan_number.h"
 
 #define TEST_OPTIMAL() 0
+#define TEST_SINGLE_EXHAUSTIVE() 0
 
 constexpr int BufSize = 64;
 
@@ -88,6 +97,7 @@ struct D2S_Grisu2
 {
     bool Optimal() const { return false; }
     const char* Name() const { return "grisu2"; }
+    char* operator()(char* buf, int /*buflen*/, float f) { return grisu2::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) { return grisu2::Dtoa(buf, f); }
 };
 
@@ -102,6 +112,7 @@ struct D2S_Grisu3
 {
     bool Optimal() const { return true; }
     const char* Name() const { return "grisu3"; }
+    char* operator()(char* buf, int /*buflen*/, float f) { return grisu3::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) { return grisu3::Dtoa(buf, f); }
 };
 
@@ -125,6 +136,7 @@ struct D2S_Dragonbox
 {
     bool Optimal() const { return true; }
     const char* Name() const { return "dragonbox"; }
+    char* operator()(char* buf, int /*buflen*/, float f) { return dragonbox::Ftoa(buf, f); }
     char* operator()(char* buf, int /*buflen*/, double f) { return dragonbox::Dtoa(buf, f); }
 };
 
@@ -296,7 +308,10 @@ static void CheckSingle(float f)
 {
     CheckSingle(D2S_DoubleConversion{}, f);
     CheckSingle(D2S_Ryu{}, f);
+    CheckSingle(D2S_Grisu2{}, f);
+    CheckSingle(D2S_Grisu3{}, f);
     CheckSingle(D2S_Schubfach{}, f);
+    CheckSingle(D2S_Dragonbox{}, f);
 }
 
 inline void CheckSingleBits(uint32_t bits)
@@ -329,7 +344,10 @@ static void CheckSingle(float value, const std::string& expected)
 {
     CheckSingle(D2S_DoubleConversion{}, value, expected);
     CheckSingle(D2S_Ryu{}, value, expected);
+    CheckSingle(D2S_Grisu2{}, value, expected);
+    CheckSingle(D2S_Grisu3{}, value, expected);
     CheckSingle(D2S_Schubfach{}, value, expected);
+    CheckSingle(D2S_Dragonbox{}, value, expected);
 }
 
 static void CheckSingleBits(uint32_t bits, const std::string& expected)
@@ -567,238 +585,1668 @@ TEST_CASE("Round10")
     CHECK( Round10(0.0095, -3) == 0.01 );
 }
 
-//==================================================================================================
-//
-//==================================================================================================
+// All rounding modes, for tests which check each of them.
+static constexpr ryu::DecimalRounding AllDecimalRoundings[] = {
+    ryu::DecimalRounding::half_away_from_zero,
+    ryu::DecimalRounding::half_even,
+    ryu::DecimalRounding::toward_zero,
+    ryu::DecimalRounding::upward,
+    ryu::DecimalRounding::downward,
+};
 
-TEST_CASE("Single")
+// Reference implementation: round the shortest digits (as a string) and read the result back in.
+static double Round10Reference(double value, int n, ryu::DecimalRounding mode)
 {
-    CheckSingle(MakeSingle(0,   0, 0x00000000), "0"            ); // +0
-    CheckSingle(MakeSingle(0,   0, 0x00000001), "1e-45"        ); // min denormal
-    CheckSingle(MakeSingle(0,   0, 0x007FFFFF), "1.1754942e-38"); // max denormal
-    CheckSingle(MakeSingle(0,   1, 0x00000000), "1.1754944e-38"); // min normal
-    CheckSingle(MakeSingle(0,   1, 0x00000001), "1.1754945e-38");
-    CheckSingle(MakeSingle(0,   1, 0x007FFFFF), "2.3509886e-38");
-    CheckSingle(MakeSingle(0,   2, 0x00000000), "2.3509887e-38");
-    CheckSingle(MakeSingle(0,   2, 0x00000001), "2.350989e-38" );
-    CheckSingle(MakeSingle(0,  24, 0x00000000), "9.8607613e-32"); // fail if no special case in normalized boundaries
-    CheckSingle(MakeSingle(0,  30, 0x00000000), "6.3108872e-30"); // fail if no special case in normalized boundaries
-    CheckSingle(MakeSingle(0,  31, 0x00000000), "1.2621775e-29"); // fail if no special case in normalized boundaries
-    CheckSingle(MakeSingle(0,  57, 0x00000000), "8.4703295e-22"); // fail if no special case in normalized boundaries
-    CheckSingle(MakeSingle(0, 254, 0x007FFFFE), "3.4028233e+38");
-    CheckSingle(MakeSingle(0, 254, 0x007FFFFF), "3.4028235e+38"); // max normal
-}
+    using ryu::DecimalRounding;
+
+    uint8_t buf[schubfach::DtoaDigitsMinBufferLength];
+    const schubfach::DecimalDigits dec = schubfach::DtoaDigits(buf, value);
+    if (dec.num_digits == 0 || value == 0 || dec.exponent >= n)
+        return value;
+
+    // value = i.tail * 10^n
+    const int keep = dec.num_digits + dec.exponent - n;
+    std::string i = "0";
+    for (int k = 0; k < keep; ++k)
+        i.push_back(static_cast<char>('0' + buf[k]));
+
+    // cmp_half = sign(tail - 1/2)
+    int cmp_half = -1;
+    if (keep >= 0)
+    {
+        cmp_half = buf[keep] < 5 ? -1 : (buf[keep] > 5 ? 1 : 0);
+        for (int k = keep + 1; cmp_half == 0 && k < dec.num_digits; ++k)
+            cmp_half = buf[k] != 0 ? 1 : 0;
+    }
 
-TEST_CASE("Single - Boundaries")
-{
-    for (uint32_t e = 2; e < 254; ++e)
+    bool up = false;
+    switch (mode)
     {
-        CAPTURE(e);
-        //CheckSingle(MakeSingle(0, e-1, 0x007FFFFE));
-        CheckSingle(MakeSingle(0, e-1, 0x007FFFFF));
-        CheckSingle(MakeSingle(0, e,   0x00000000));
-        //CheckSingle(MakeSingle(0, e,   0x00000001));
-        //CheckSingle(MakeSingle(0, e,   0x00000002));
-        //CheckSingle(MakeSingle(0, e,   0x002AAAAA));
-        //CheckSingle(MakeSingle(0, e,   0x00555555));
-        //CheckSingle(MakeSingle(0, e,   0x00400000));
+    case DecimalRounding::half_away_from_zero:
+        up = cmp_half >= 0;
+        break;
+    case DecimalRounding::half_even:
+        up = cmp_half > 0 || (cmp_half == 0 && (i.back() - '0') % 2 != 0);
+        break;
+    case DecimalRounding::toward_zero:
+        break;
+    case DecimalRounding::upward:
+        up = !dec.negative;
+        break;
+    case DecimalRounding::downward:
+        up = dec.negative;
+        break;
+    }
+
+    if (up)
+    {
+        size_t k = i.size() - 1;
+        while (i[k] == '9')
+            i[k--] = '0';
+        i[k]++;
     }
+
+    i += "e" + std::to_string(n);
+    const double flt = std::strtod(i.c_str(), nullptr);
+    return dec.negative ? -flt : flt;
 }
 
-TEST_CASE("Single - Paxson, Kahan")
+TEST_CASE("Round10 - rounding modes")
 {
-    // V. Paxson and W. Kahan, "A Program for Testing IEEE Binary-Decimal Conversion", manuscript, May 1991,
-    // ftp://ftp.ee.lbl.gov/testbase-report.ps.Z    (report)
-    // ftp://ftp.ee.lbl.gov/testbase.tar.Z          (program)
+    using ryu::Round10;
+    using ryu::DecimalRounding;
+
+    CHECK( Round10(2.675, -2, DecimalRounding::half_even) == 2.68 );
+    CHECK( Round10(2.665, -2, DecimalRounding::half_even) == 2.66 );
+    CHECK( Round10(2.665, -2, DecimalRounding::half_away_from_zero) == 2.67 );
+    CHECK( Round10(-2.665, -2, DecimalRounding::half_even) == -2.66 );
+    CHECK( Round10(-2.665, -2, DecimalRounding::half_away_from_zero) == -2.67 );
+    CHECK( Round10(0.5, 0, DecimalRounding::half_even) == 0.0 );
+    CHECK( Round10(1.5, 0, DecimalRounding::half_even) == 2.0 );
+    CHECK( Round10(2.5, 0, DecimalRounding::half_even) == 2.0 );
+    CHECK( Round10(25.0, 1, DecimalRounding::half_even) == 20.0 );
+    CHECK( Round10(35.0, 1, DecimalRounding::half_even) == 40.0 );
+    CHECK( Round10(2.5000001, 0, DecimalRounding::half_even) == 3.0 );
+
+    CHECK( Round10(1.239, -2, DecimalRounding::toward_zero) == 1.23 );
+    CHECK( Round10(-1.239, -2, DecimalRounding::toward_zero) == -1.23 );
+    CHECK( Round10(1.239, -2, DecimalRounding::downward) == 1.23 );
+    CHECK( Round10(-1.231, -2, DecimalRounding::downward) == -1.24 );
+    CHECK( Round10(1.231, -2, DecimalRounding::upward) == 1.24 );
+    CHECK( Round10(-1.239, -2, DecimalRounding::upward) == -1.23 );
+    CHECK( Round10(1.23, -2, DecimalRounding::upward) == 1.23 );
+    CHECK( Round10(-1.23, -2, DecimalRounding::downward) == -1.23 );
+    CHECK( Round10(0.1 + 0.2, -1, DecimalRounding::downward) == 0.3 );
+    CHECK( Round10(0.1 + 0.2, -1, DecimalRounding::upward) == 0.4 );
+
+    // |x| < 1/10 and |x| < 1
+    CHECK( Round10(1e-20, -2, DecimalRounding::upward) == 0.01 );
+    CHECK( Round10(1e-20, -2, DecimalRounding::downward) == 0.0 );
+    CHECK( Round10(-1e-20, -2, DecimalRounding::downward) == -0.01 );
+    CHECK( std::signbit(Round10(-1e-20, -2, DecimalRounding::upward)) );
+    CHECK( Round10(0.004, -2, DecimalRounding::upward) == 0.01 );
+    CHECK( Round10(0.005, -2, DecimalRounding::half_even) == 0.0 );
+    CHECK( Round10(0.015, -2, DecimalRounding::half_even) == 0.02 );
+    CHECK( Round10(0.025, -2, DecimalRounding::half_even) == 0.02 );
+
+    CHECK( Round10(2.5f, 0, DecimalRounding::half_even) == 2.0f );
+    CHECK( Round10(2.665f, -2, DecimalRounding::half_even) == 2.66f );
+    CHECK( Round10(-1.231f, -2, DecimalRounding::downward) == -1.24f );
+    CHECK( Round10(1e-20f, -2, DecimalRounding::upward) == 0.01f );
+
+    CHECK( Round10(std::numeric_limits<double>::max(), 306, DecimalRounding::upward) == std::numeric_limits<double>::infinity() );
+    CHECK( Round10(std::numeric_limits<double>::max(), 306, DecimalRounding::toward_zero) == 1.79e+308 );
+    CHECK( Round10(std::numeric_limits<double>::infinity(), -2, DecimalRounding::downward) == std::numeric_limits<double>::infinity() );
+    CHECK( std::isnan(Round10(std::numeric_limits<double>::quiet_NaN(), -2, DecimalRounding::upward)) );
+
+    std::mt19937_64 rng;
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(ReinterpretBits<double>(rng() & 0x7FEFFFFFFFFFFFFF));
+        values.push_back(static_cast<double>(rng() % 100000000) / std::pow(10.0, (rng() % 12)));
+        values.push_back(-static_cast<double>(rng() % 1000) / std::pow(10.0, (rng() % 6)));
+    }
 
-    // Table 16: Stress Inputs for Converting 24-bit Binary to Decimal, < 1/2 ULP
-    CheckSingle(MakeSingle(12676506, -102), "2.5e-24"        ); // digits  1, bits 32
-    CheckSingle(MakeSingle(12676506, -103), "1.25e-24"       ); // digits  2, bits 29
-    CheckSingle(MakeSingle(15445013,  +86), "1.195e+33"      ); // digits  3, bits 34
-    CheckSingle(MakeSingle(13734123, -138), "3.9415e-35"     ); // digits  4, bits 32
-    CheckSingle(MakeSingle(12428269, -130), "9.13085e-33"    ); // digits  5, bits 30
-    CheckSingle(MakeSingle(15334037, -146), "1.719005e-37"   ); // digits  6, bits 31
-    CheckSingle(MakeSingle(11518287,  -41), "0.0000052379105"); // digits  7, bits 30
-    CheckSingle(MakeSingle(12584953, -145), "2.821644e-37"   ); // digits  8, bits 31
-    CheckSingle(MakeSingle(15961084, -125), "3.7524328e-31"  ); // digits  9, bits 32
-    CheckSingle(MakeSingle(14915817, -146), "1.6721209e-37"  ); // digits 10, bits 31
-    CheckSingle(MakeSingle(10845484, -102), "2.1388946e-24"  ); // digits 11, bits 30
-    CheckSingle(MakeSingle(16431059,  -61), "7.125836e-12"   ); // digits 12, bits 29
+    for (const DecimalRounding mode : AllDecimalRoundings)
+    {
+        CAPTURE(static_cast<int>(mode));
+        for (int n = -20; n <= 20; ++n)
+        {
+            CAPTURE(n);
+            for (const double value : values)
+            {
+                const double result = Round10(value, n, mode);
+                const double expected = Round10Reference(value, n, mode);
+                if (result != expected)
+                {
+                    CAPTURE(value);
+                    CAPTURE(result);
+                    CAPTURE(expected);
+                    CHECK(false);
+                }
+                if (mode == DecimalRounding::half_away_from_zero)
+                {
+                    CHECK(ReinterpretBits<uint64_t>(result) == ReinterpretBits<uint64_t>(Round10(value, n)));
+                }
+            }
+        }
+    }
+}
 
-    // Table 17: Stress Inputs for Converting 24-bit Binary to Decimal, > 1/2 ULP
-    CheckSingle(MakeSingle(16093626,  +69), "9.5e+27"              ); // digits  1, bits 30
-    CheckSingle(MakeSingle( 9983778,  +25), "335000000000000"      ); // digits  2, bits 31
-    CheckSingle(MakeSingle(12745034, +104), "2.585e+38"            ); // digits  3, bits 31
-    CheckSingle(MakeSingle(12706553,  +72), "6.0005e+28"           ); // digits  4, bits 31
-    CheckSingle(MakeSingle(11005028,  +45), "387205000000000000000"); // digits  5, bits 30
-    CheckSingle(MakeSingle(15059547,  +71), "3.555835e+28"         ); // digits  6, bits 31
-    CheckSingle(MakeSingle(16015691,  -99), "2.5268305e-23"        ); // digits  7, bits 29
-    CheckSingle(MakeSingle( 8667859,  +56), "6.245851e+23"         ); // digits  8, bits 33
-    CheckSingle(MakeSingle(14855922,  -82), "3.0721327e-18"        ); // digits  9, bits 35
-    CheckSingle(MakeSingle(14855922,  -83), "1.5360663e-18"        ); // digits 10, bits 33
-    CheckSingle(MakeSingle(10144164, -110), "7.81478e-27"          ); // digits 11, bits 32
-    CheckSingle(MakeSingle(13248074,  +95), "5.2481028e+35"        ); // digits 12, bits 33
+static std::string DtoaRoundedString(double value, int decimals, ryu::DecimalRounding mode = ryu::DecimalRounding::half_away_from_zero)
+{
+    char buf[ryu::DtoaMinBufferLength];
+    char* end = ryu::DtoaRounded(buf, value, decimals, mode);
+    return std::string(buf, end);
 }
 
-TEST_CASE("Single - Regression")
+static std::string DtoaRound10String(double value, int decimals, ryu::DecimalRounding mode = ryu::DecimalRounding::half_away_from_zero)
 {
-    CheckSingle(7.0385307e-26f);
+    char buf[ryu::DtoaMinBufferLength];
+    char* end = ryu::Dtoa(buf, ryu::Round10(value, -decimals, mode));
+    return std::string(buf, end);
+}
 
-    CheckSingleBits(0x4C000009, "33554468");
-    CheckSingleBits(0x4C800009, "67108936");
-    CheckSingleBits(0x4D00001D, "134218190");
-    CheckSingleBits(0x4D80001D, "268436380");
-    CheckSingleBits(0x4E00001D, "536872770");
-    CheckSingleBits(0x4E80004F, "1073751900");
-    CheckSingleBits(0x4F00004F, "2147503900");
-    CheckSingleBits(0x4F80004F, "4295007700");
-    CheckSingleBits(0x50000437, "8591039000");
-    CheckSingleBits(0x50800437, "17182079000");
-    CheckSingleBits(0x51000437, "34364158000");
-    CheckSingleBits(0x51800437, "68728316000");
-    CheckSingleBits(0x52000DFB, "137497590000");
-    CheckSingleBits(0x52800DFB, "274995180000");
-    CheckSingleBits(0x53000DFB, "549990370000");
-    CheckSingleBits(0x53802665, "1100799900000");
-    CheckSingleBits(0x54002665, "2201599900000");
-    CheckSingleBits(0x54802665, "4403199700000");
-    CheckSingleBits(0x55002665, "8806399000000");
-    CheckSingleBits(0x55802665, "17612799000000");
-    CheckSingleBits(0x56002665, "35225598000000");
-    CheckSingleBits(0x56802665, "70451196000000");
-    CheckSingleBits(0x57002665, "140902390000000");
-    CheckSingleBits(0x57802665, "281804780000000");
-    CheckSingleBits(0x58002665, "563609570000000");
-    CheckSingleBits(0x58A3E9AB, "1441791900000000");
-    CheckSingleBits(0x5923E9AB, "2883583900000000");
-    CheckSingleBits(0x59A3E9AB, "5767167700000000");
-    CheckSingleBits(0x5A5F8475, "15728639000000000");
-    CheckSingleBits(0x5ADF8475, "31457279000000000");
-    CheckSingleBits(0x5B5F8475, "62914558000000000");
-    CheckSingleBits(0x5BDF8475, "125829116000000000");
+TEST_CASE("DtoaRounded")
+{
+    using ryu::DecimalRounding;
+
+    CHECK(DtoaRoundedString(1.005, 2) == "1.01");
+    CHECK(DtoaRoundedString(0.1 + 0.2, 2) == "0.3");
+    CHECK(DtoaRoundedString(1.96, 1) == "2");
+    CHECK(DtoaRoundedString(-1.96, 1) == "-2");
+    CHECK(DtoaRoundedString(-0.001, 2) == "-0");
+    CHECK(DtoaRoundedString(0.001, 2, DecimalRounding::upward) == "0.01");
+    CHECK(DtoaRoundedString(2.665, 2, DecimalRounding::half_even) == "2.66");
+    CHECK(DtoaRoundedString(55.0, -1) == "60");
+    CHECK(DtoaRoundedString(123.0, 2) == "123");
+    CHECK(DtoaRoundedString(0.0, 2) == "0");
+    CHECK(DtoaRoundedString(-0.0, 2) == "-0");
+    CHECK(DtoaRoundedString(std::numeric_limits<double>::infinity(), 2) == "inf");
+    CHECK(DtoaRoundedString(-std::numeric_limits<double>::infinity(), 2) == "-inf");
+    CHECK(DtoaRoundedString(std::numeric_limits<double>::quiet_NaN(), 2) == "nan");
+
+    std::mt19937_64 rng;
+    std::vector<double> values = {
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::denorm_min(),
+        1.7976931348623157e+308,
+        9.9999999999999999e+307,
+        2.2250738585072014e-308,
+        1e-310,
+        5e-324,
+    };
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(ReinterpretBits<double>(rng()));
+        values.push_back(static_cast<double>(rng() % 100000000) / std::pow(10.0, (rng() % 12)));
+        values.push_back(static_cast<double>(rng() % 100000000000000000) / std::pow(10.0, (rng() % 30)));
+    }
 
-    CheckSingleBits(0x4D00001E, "134218200");
-    CheckSingleBits(0x4D80001E, "268436400");
-    CheckSingleBits(0x4E800050, "1073752000");
-    CheckSingleBits(0x4F800050, "4295008000");
-    CheckSingleBits(0x50000438, "8591040000");
-    CheckSingleBits(0x52000DFC, "137497600000");
-    CheckSingleBits(0x52800DFC, "274995200000");
-    CheckSingleBits(0x53802666, "1100800000000");
-    CheckSingleBits(0x54802666, "4403200000000");
-    CheckSingleBits(0x55002666, "8806400000000");
-    CheckSingleBits(0x57002666, "140902400000000");
-    CheckSingleBits(0x57802666, "281804800000000");
-    CheckSingleBits(0x58A3E9AC, "1441792000000000");
-    CheckSingleBits(0x59A3E9AC, "5767168000000000");
-    CheckSingleBits(0x5A5F8476, "15728640000000000");
+    for (const DecimalRounding mode : AllDecimalRoundings)
+    {
+        CAPTURE(static_cast<int>(mode));
+        for (const int decimals : {-1001, -310, -300, -20, -10, -2, -1, 0, 1, 2, 3, 4, 5, 6, 8, 10, 12, 14, 15, 16, 17, 18, 20, 25, 30, 100, 300, 306, 307, 308, 310, 320, 323, 324, 330, 1001})
+        {
+            CAPTURE(decimals);
+            for (const double value : values)
+            {
+                const std::string str = DtoaRoundedString(value, decimals, mode);
+                const std::string expected = DtoaRound10String(value, decimals, mode);
+                if (str != expected)
+                {
+                    CAPTURE(value);
+                    CHECK(str == expected);
+                }
+            }
+        }
+    }
 }
 
-TEST_CASE("Single - Ryu")
+TEST_CASE("Round10Batch")
 {
-    CheckSingleBits(0x3800000A, "0.000030517615");
-    CheckSingleBits(0x3880001E, "0.000061035375");
-    CheckSingleBits(0x390000FB, "0.00012207397");
-    CheckSingleBits(0x39800091, "0.00024414485");
-    CheckSingleBits(0x3A000024, "0.00048828335");
-    CheckSingleBits(0x3A80020F, "0.0009766239");
-    CheckSingleBits(0x3B000020, "0.0019531325");
-    CheckSingleBits(0x3B800007, "0.0039062533");
-    CheckSingleBits(0x3C800028, "0.015625075");
-    CheckSingleBits(0x3D000014, "0.031250075");
-    CheckSingleBits(0x3D80000A, "0.062500075");
-    CheckSingleBits(0x3E000032, "0.12500075");
-    CheckSingleBits(0x3E800019, "0.25000075");
-    CheckSingleBits(0x3F000024, "0.50000215");
-    CheckSingleBits(0x3F80008A, "1.0000165");
-    CheckSingleBits(0x40000045, "2.0000165");
-    CheckSingleBits(0x40800020, "4.0000153");
-    CheckSingleBits(0x418000E8, "16.000443");
-    CheckSingleBits(0x42000074, "32.000443");
-    CheckSingleBits(0x4280004A, "64.000565");
-    CheckSingleBits(0x4300003A, "128.00089");
-    CheckSingleBits(0x43800091, "256.00443");
-    CheckSingleBits(0x4400003F, "512.00385");
-    CheckSingleBits(0x448000B3, "1024.0219");
-    CheckSingleBits(0x45000111, "2048.0667");
-    CheckSingleBits(0x45800015, "4096.0103");
+    std::vector<double> values = {
+        0.0, -0.0, 1.005, -1.005, 0.015, 0.545, 55.55, 55.549999999999997, 3544.5249, 0.1 + 0.2,
+        0.5, 1.5, 2.5, -0.5, 0.05, 0.005, 55.0, 54.9, -55.1, 1e-300, -1e-300, 1e+300,
+        std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::max(),
+        -std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(),
+    };
+
+    std::mt19937_64 rng;
+    for (int e = -8; e <= 20; ++e)
+    {
+        std::uniform_real_distribution<double> gen(0.0, std::pow(10.0, e));
+        for (int i = 0; i < 500; ++i)
+        {
+            const double value = gen(rng);
+            values.push_back((rng() & 1) ? -value : value);
+        }
 
-    CheckSingleBits(0x39800000, "0.00024414062");
-    CheckSingleBits(0x3B200000, "0.0024414062");
-    CheckSingleBits(0x3B900000, "0.0043945312");
-    CheckSingleBits(0x3C880000, "0.016601562");
-    CheckSingleBits(0x3D040000, "0.032226562");
-    CheckSingleBits(0x3E020000, "0.12695312");
-    CheckSingleBits(0x3E810000, "0.25195312");
-    CheckSingleBits(0x3F808000, "1.0039062");
-    CheckSingleBits(0x40004000, "2.0039062");
-    CheckSingleBits(0x40802000, "4.0039062");
-    CheckSingleBits(0x41801000, "16.007812");
-    CheckSingleBits(0x42000800, "32.007812");
-    CheckSingleBits(0x43000400, "128.01562");
-    CheckSingleBits(0x43800200, "256.01562");
-    CheckSingleBits(0x44800100, "1024.0312");
-    CheckSingleBits(0x45000080, "2048.0312");
-    CheckSingleBits(0x45800040, "4096.0312");
-    CheckSingleBits(0x46800020, "16384.062");
-    CheckSingleBits(0x47000010, "32768.062");
-    CheckSingleBits(0x48000008, "131072.12");
-    CheckSingleBits(0x48800004, "262144.12");
-    CheckSingleBits(0x49800002, "1048576.2");
+        // Numbers with few decimal places, which are often close to ties.
+        for (int i = 0; i < 500; ++i)
+        {
+            const double value = static_cast<double>(rng() % 100000000) / std::pow(10.0, (rng() % 8));
+            values.push_back(value * std::pow(10.0, e));
+        }
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(ReinterpretBits<double>(rng()));
+    }
 
-    CheckSingleBits(0x4F80001E, "4294982700");
-    CheckSingleBits(0x51000002, "34359747000");
-    CheckSingleBits(0x51800142, "68722115000");
-    CheckSingleBits(0x5300016F, "549779870000");
-    CheckSingleBits(0x54801E57, "4402118700000");
-    CheckSingleBits(0x56004279, "35255747000000");
-    CheckSingleBits(0x5680DC48, "70841795000000");
-    CheckSingleBits(0x580214C8, "572103070000000");
-    CheckSingleBits(0x5984CC95, "4672454700000000");
-    CheckSingleBits(0x5B00BEFC, "36238787000000000");
-    CheckSingleBits(0x5B99C7AD, "86570435000000000");
+    std::vector<double> results(values.size());
+    for (int n = -25; n <= 25; ++n)
+    {
+        CAPTURE(n);
+
+        // Odd count, to check the remainder loop.
+        ryu::Round10Batch(values.data(), results.data(), values.size() - 1, n);
+        for (size_t i = 0; i + 1 < values.size(); ++i)
+        {
+            const double expected = ryu::Round10(values[i], n);
+            if (ReinterpretBits<uint64_t>(results[i]) != ReinterpretBits<uint64_t>(expected) && !(std::isnan(expected) && std::isnan(results[i])))
+            {
+                CAPTURE(values[i]);
+                CAPTURE(results[i]);
+                CAPTURE(expected);
+                CHECK(false);
+            }
+        }
+    }
+
+    for (const int n : {-1001, -1000, 1000, 1001})
+    {
+        ryu::Round10Batch(values.data(), results.data(), values.size(), n);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const double expected = ryu::Round10(values[i], n);
+            CHECK((ReinterpretBits<uint64_t>(results[i]) == ReinterpretBits<uint64_t>(expected) || (std::isnan(expected) && std::isnan(results[i]))));
+        }
+    }
+
+    // In-place.
+    std::vector<double> inplace = values;
+    ryu::Round10Batch(inplace.data(), inplace.data(), inplace.size(), -2);
+    ryu::Round10Batch(values.data(), results.data(), values.size(), -2);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        CHECK((ReinterpretBits<uint64_t>(inplace[i]) == ReinterpretBits<uint64_t>(results[i]) || std::isnan(values[i])));
+    }
 }
 
-TEST_CASE("Double")
+// Reference implementation: round the shortest digits (as a string) and read the result back in.
+// For single-precision numbers, the shortest digits of the float are the shortest digits of
+// (double)Ftoa(value), since these have at most 9 digits.
+template <typename Float>
+static Float RoundSignificantReference(Float value, int digits)
 {
-    CheckDouble(MakeDouble(20, -1074), "1e-322");
+    char str_value[BufSize];
+    char* end = (sizeof(Float) == 4) ? ryu::Ftoa(str_value, static_cast<float>(value)) : ryu::Dtoa(str_value, static_cast<double>(value));
+    *end = '\0';
 
-    CheckDouble(MakeDouble(0,    0, 0x0000000000000000), "0"                      ); // +0
-    CheckDouble(MakeDouble(0,    0, 0x0000000000000001), "5e-324"                 ); // min denormal
-    CheckDouble(MakeDouble(0,    0, 0x000FFFFFFFFFFFFF), "2.225073858507201e-308" ); // max denormal
-    CheckDouble(MakeDouble(0,    1, 0x0000000000000000), "2.2250738585072014e-308"); // min normal
-    CheckDouble(MakeDouble(0,    1, 0x0000000000000001), "2.225073858507202e-308" );
-    CheckDouble(MakeDouble(0,    1, 0x000FFFFFFFFFFFFF), "4.4501477170144023e-308");
-    CheckDouble(MakeDouble(0,    2, 0x0000000000000000), "4.450147717014403e-308" );
-    CheckDouble(MakeDouble(0,    2, 0x0000000000000001), "4.450147717014404e-308" );
-    CheckDouble(MakeDouble(0,    4, 0x0000000000000000), "1.7800590868057611e-307"); // fail if no special case in normalized boundaries
-    CheckDouble(MakeDouble(0,    5, 0x0000000000000000), "3.5601181736115222e-307"); // fail if no special case in normalized boundaries
-    CheckDouble(MakeDouble(0,    6, 0x0000000000000000), "7.120236347223045e-307" ); // fail if no special case in normalized boundaries
-    CheckDouble(MakeDouble(0,   10, 0x0000000000000000), "1.1392378155556871e-305"); // fail if no special case in normalized boundaries
-    CheckDouble(MakeDouble(0, 2046, 0x000FFFFFFFFFFFFE), "1.7976931348623155e+308");
-    CheckDouble(MakeDouble(0, 2046, 0x000FFFFFFFFFFFFF), "1.7976931348623157e+308"); // max normal
-}
+    uint8_t buf[schubfach::DtoaDigitsMinBufferLength];
+    const schubfach::DecimalDigits dec = schubfach::DtoaDigits(buf, std::strtod(str_value, nullptr));
+    if (dec.num_digits == 0 || value == 0 || digits < 1 || dec.num_digits <= digits)
+        return value;
 
-//inline void CheckPermutations(uint64_t e, uint64_t f)
-//{
-//    uint64_t p = next_permutation(f);
-//
-////  while (p != f && p <= 0x000FFFFFFFFFFFFF)
-//    for (int i = 0; i < 10 && p <= 0x000FFFFFFFFFFFFF; ++i)
-//    {
-//        CAPTURE(p);
-//        CheckDouble(MakeDouble(0, e, p));
-//        p = next_permutation(p);
-//    }
-//}
+    std::string str(1, '0'); // Leading zero for the carry.
+    for (int i = 0; i < digits; ++i)
+        str.push_back(static_cast<char>('0' + buf[i]));
 
-TEST_CASE("Double - Boundaries")
+    if (buf[digits] >= 5)
+    {
+        size_t k = str.size() - 1;
+        while (str[k] == '9')
+            str[k--] = '0';
+        str[k]++;
+    }
+
+    str += "e" + std::to_string(dec.exponent + (dec.num_digits - digits));
+    const Float flt = (sizeof(Float) == 4) ? static_cast<Float>(std::strtof(str.c_str(), nullptr)) : static_cast<Float>(std::strtod(str.c_str(), nullptr));
+    return dec.negative ? -flt : flt;
+}
+
+TEST_CASE("RoundSignificant")
 {
-    //CheckDouble(MakeDouble(0, 1080-1, 0x000FFFFFFFFFFFFF));
+    using ryu::RoundSignificant;
+
+    CHECK( RoundSignificant(123456.0, 2) == 120000.0 );
+    CHECK( RoundSignificant(123456.0, 3) == 123000.0 );
+    CHECK( RoundSignificant(-123456.0, 3) == -123000.0 );
+    CHECK( RoundSignificant(0.000123456, 3) == 0.000123 );
+    CHECK( RoundSignificant(1.005, 3) == 1.01 );
+    CHECK( RoundSignificant(999.5, 3) == 1000.0 );
+    CHECK( RoundSignificant(9.995, 3) == 10.0 );
+    CHECK( RoundSignificant(9.96, 2) == 10.0 );
+    CHECK( RoundSignificant(0.09995, 3) == 0.1 );
+    CHECK( RoundSignificant(0.1 + 0.2, 15) == 0.3 );
+    CHECK( RoundSignificant(0.1 + 0.2, 16) == 0.3 );
+    CHECK( RoundSignificant(0.1 + 0.2, 17) == 0.1 + 0.2 );
+    CHECK( RoundSignificant(55.0, 1) == 60.0 );
+    CHECK( RoundSignificant(54.9, 1) == 50.0 );
+    CHECK( RoundSignificant(54.9, 0) == 54.9 );
+    CHECK( RoundSignificant(54.9, -1) == 54.9 );
+    CHECK( RoundSignificant(1e+300, 1) == 1e+300 );
+    CHECK( RoundSignificant(1.5e-323, 1) == 2e-323 );
+    CHECK( RoundSignificant(std::numeric_limits<double>::max(), 17) == std::numeric_limits<double>::max() );
+    CHECK( RoundSignificant(std::numeric_limits<double>::max(), 2) == std::numeric_limits<double>::infinity() );
+    CHECK( RoundSignificant(std::numeric_limits<double>::max(), 1) == std::numeric_limits<double>::infinity() );
+    CHECK( RoundSignificant(-std::numeric_limits<double>::max(), 1) == -std::numeric_limits<double>::infinity() );
+    CHECK( RoundSignificant(std::numeric_limits<double>::infinity(), 1) == std::numeric_limits<double>::infinity() );
+    CHECK( std::isnan(RoundSignificant(std::numeric_limits<double>::quiet_NaN(), 1)) );
+    CHECK( std::signbit(RoundSignificant(-0.0, 1)) );
+
+    CHECK( RoundSignificant(123456.0f, 2) == 120000.0f );
+    CHECK( RoundSignificant(1.005f, 3) == 1.01f );
+    CHECK( RoundSignificant(-9.995f, 3) == -10.0f );
+    CHECK( RoundSignificant(0.09995f, 3) == 0.1f );
+    CHECK( RoundSignificant(std::numeric_limits<float>::max(), 2) == 3.4e+38f );
+    CHECK( RoundSignificant(std::numeric_limits<float>::max(), 1) == 3e+38f );
+    CHECK( RoundSignificant(std::numeric_limits<float>::max(), 7) == std::numeric_limits<float>::infinity() );
+    CHECK( std::signbit(RoundSignificant(-0.0f, 1)) );
+
+    std::mt19937_64 rng;
+    std::vector<double> values;
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.push_back(ReinterpretBits<double>(rng() & 0x7FEFFFFFFFFFFFFF));
+        values.push_back(static_cast<double>(rng() % 100000000) / std::pow(10.0, (rng() % 12)));
+    }
 
-    for (uint64_t e = 2; e < 2046; ++e)
+    std::vector<double> results(values.size());
+    for (int digits = 1; digits <= 17; ++digits)
     {
-        CAPTURE(e);
+        CAPTURE(digits);
+
+        ryu::RoundSignificantBatch(values.data(), results.data(), values.size(), digits);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const double expected = RoundSignificantReference(values[i], digits);
+            if (results[i] != expected)
+            {
+                CAPTURE(values[i]);
+                CAPTURE(results[i]);
+                CAPTURE(expected);
+                CHECK(false);
+            }
+        }
+    }
+
+    std::vector<float> fvalues;
+    for (int i = 0; i < 2000; ++i)
+    {
+        fvalues.push_back(ReinterpretBits<float>(static_cast<uint32_t>(rng() % 0x7F800000)));
+    }
+
+    std::vector<float> fresults(fvalues.size());
+    for (int digits = 1; digits <= 9; ++digits)
+    {
+        CAPTURE(digits);
+
+        ryu::RoundSignificantBatch(fvalues.data(), fresults.data(), fvalues.size(), digits);
+        for (size_t i = 0; i < fvalues.size(); ++i)
+        {
+            const float expected = RoundSignificantReference(fvalues[i], digits);
+            CHECK(fresults[i] == expected);
+        }
+    }
+
+    // Rounding modes.
+    using ryu::DecimalRounding;
+
+    CHECK( RoundSignificant(2.5, 1, DecimalRounding::half_even) == 2.0 );
+    CHECK( RoundSignificant(3.5, 1, DecimalRounding::half_even) == 4.0 );
+    CHECK( RoundSignificant(-1.239, 3, DecimalRounding::downward) == -1.24 );
+    CHECK( RoundSignificant(-1.239, 3, DecimalRounding::upward) == -1.23 );
+    CHECK( RoundSignificant(1.231, 3, DecimalRounding::upward) == 1.24 );
+    CHECK( RoundSignificant(1.239, 3, DecimalRounding::toward_zero) == 1.23 );
+    CHECK( RoundSignificant(9.91, 1, DecimalRounding::upward) == 10.0 );
+    CHECK( RoundSignificant(std::numeric_limits<double>::max(), 1, DecimalRounding::toward_zero) == 1e+308 );
+    CHECK( RoundSignificant(2.5f, 1, DecimalRounding::half_even) == 2.0f );
+    CHECK( RoundSignificant(-1.239f, 3, DecimalRounding::downward) == -1.24f );
+    CHECK( RoundSignificant(1.239f, 3, DecimalRounding::toward_zero) == 1.23f );
+
+    for (const DecimalRounding mode : AllDecimalRoundings)
+    {
+        CAPTURE(static_cast<int>(mode));
+
+        for (int digits = 1; digits <= 17; ++digits)
+        {
+            CAPTURE(digits);
+
+            ryu::RoundSignificantBatch(values.data(), results.data(), values.size(), digits, mode);
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                // Rounding to digits significant digits is the same as rounding to a multiple of
+                // 10^n, where n = e + num_digits - digits.
+                uint8_t buf[schubfach::DtoaDigitsMinBufferLength];
+                const schubfach::DecimalDigits dec = schubfach::DtoaDigits(buf, values[i]);
+                const int n = dec.exponent + dec.num_digits - digits;
+
+                const double expected = Round10Reference(values[i], n, mode);
+                if (results[i] != expected)
+                {
+                    CAPTURE(values[i]);
+                    CAPTURE(results[i]);
+                    CAPTURE(expected);
+                    CHECK(false);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Decimal64 BID")
+{
+    using ryu::DoubleToDecimal64BID;
+    using ryu::Decimal64BIDToDouble;
+
+    CHECK(DoubleToDecimal64BID(0.0)    == 0x31C0000000000000ull);
+    CHECK(DoubleToDecimal64BID(-0.0)   == 0xB1C0000000000000ull);
+    CHECK(DoubleToDecimal64BID(1.0)    == 0x31C0000000000001ull);
+    CHECK(DoubleToDecimal64BID(-1.0)   == 0xB1C0000000000001ull);
+    CHECK(DoubleToDecimal64BID(0.1)    == 0x31A0000000000001ull);
+    CHECK(DoubleToDecimal64BID(100.0)  == 0x31C0000000000064ull); // 100 * 10^0, not 1 * 10^2
+    CHECK(DoubleToDecimal64BID(9999999999999998.0) == 0x6C7386F26FC0FFFEull); // coefficient >= 2^53
+    CHECK(DoubleToDecimal64BID(0.1 + 0.2) == 0x2FCAA87BEE538000ull); // 0.30000000000000004 => 3000000000000000 * 10^-16
+    CHECK(DoubleToDecimal64BID(std::numeric_limits<double>::infinity())  == 0x7800000000000000ull);
+    CHECK(DoubleToDecimal64BID(-std::numeric_limits<double>::infinity()) == 0xF800000000000000ull);
+    CHECK(DoubleToDecimal64BID(std::numeric_limits<double>::quiet_NaN()) == 0x7C00000000000000ull);
+
+    CHECK(Decimal64BIDToDouble(0x31C0000000000000ull) == 0.0);
+    CHECK(std::signbit(Decimal64BIDToDouble(0xB1C0000000000000ull)));
+    CHECK(Decimal64BIDToDouble(0x31A0000000000001ull) == 0.1);
+    CHECK(Decimal64BIDToDouble(0x6C7386F26FC0FFFEull) == 9999999999999998.0);
+    CHECK(Decimal64BIDToDouble(0x6FFFFFFFFFFFFFFFull) == 0.0); // non-canonical
+    CHECK(Decimal64BIDToDouble(0x0000000000000001ull) == 0.0); // 10^-398
+    CHECK(Decimal64BIDToDouble(0x77FB86F26FC0FFFFull) == std::numeric_limits<double>::infinity()); // (10^16 - 1) * 10^369
+    CHECK(Decimal64BIDToDouble(0xF800000000000000ull) == -std::numeric_limits<double>::infinity());
+    CHECK(std::isnan(Decimal64BIDToDouble(0x7C00000000000000ull)));
+    CHECK(std::isnan(Decimal64BIDToDouble(0x7E00000000000000ull)));
+
+    // Compare against the shortest representation and (for 17-digit inputs) against printf,
+    // which rounds the exact binary value.
+
+    std::mt19937_64 rng;
+    std::vector<double> values;
+    std::vector<uint64_t> bids;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double value = ReinterpretBits<double>(rng());
+        if (!std::isfinite(value))
+            continue;
+
+        const uint64_t bid = DoubleToDecimal64BID(value);
+        values.push_back(value);
+        bids.push_back(bid);
+
+        CAPTURE(value);
+        CAPTURE(bid);
+
+        char buf[BufSize];
+        char* end = ryu::Dtoa(buf, std::abs(value));
+        const auto shortest = ScanNumber(buf, end);
+
+        if (shortest.digits.size() <= 16)
+        {
+            CHECK(Decimal64BIDToDouble(bid) == value);
+        }
+        else
+        {
+            // Only canonical encodings are produced, so the coefficient is in the lower 51 bits
+            // (with an implicit 100 prefix) or in the lower 53 bits.
+            const uint64_t coefficient = (bid & 0x6000000000000000ull) == 0x6000000000000000ull
+                ? ((bid & ((uint64_t{1} << 51) - 1)) | (uint64_t{1} << 53))
+                : (bid & ((uint64_t{1} << 53) - 1));
+            const int exponent = (bid & 0x6000000000000000ull) == 0x6000000000000000ull
+                ? static_cast<int>((bid >> 51) & 0x3FF) - 398
+                : static_cast<int>((bid >> 53) & 0x3FF) - 398;
+
+            // d.ddddddddddddddde[+-]nnn
+            char expected[64];
+            std::snprintf(expected, sizeof(expected), "%.15e", std::abs(value));
+            REQUIRE(expected[1] == '.');
+            REQUIRE(expected[17] == 'e');
+
+            uint64_t expected_coefficient = static_cast<uint64_t>(expected[0] - '0');
+            for (int k = 2; k < 17; ++k)
+                expected_coefficient = 10 * expected_coefficient + static_cast<uint64_t>(expected[k] - '0');
+            const int expected_exponent = std::atoi(expected + 18) - 15;
+
+            CHECK(coefficient == expected_coefficient);
+            CHECK(exponent == expected_exponent);
+
+            const double rounded = std::strtod(expected, nullptr);
+            CHECK(Decimal64BIDToDouble(bid) == (value < 0 ? -rounded : rounded));
+        }
+    }
+
+    std::vector<uint64_t> batch_bids(values.size());
+    ryu::DoubleToDecimal64BIDBatch(values.data(), values.size(), batch_bids.data());
+    CHECK(batch_bids == bids);
+
+    std::vector<double> batch_values(bids.size());
+    ryu::Decimal64BIDToDoubleBatch(bids.data(), bids.size(), batch_values.data());
+    for (size_t i = 0; i < bids.size(); ++i)
+    {
+        CHECK(batch_values[i] == ryu::Decimal64BIDToDouble(bids[i]));
+    }
+}
+
+static void CheckDtoaDigits(double value)
+{
+    CAPTURE(value);
+
+    char buf[BufSize];
+    char* end = schubfach::Dtoa(buf, std::abs(value));
+    const auto expected = ScanNumber(buf, end);
+
+    uint8_t digits[schubfach::DtoaDigitsMinBufferLength];
+    const auto dec = schubfach::DtoaDigits(digits, value);
+
+    std::string actual;
+    for (int i = 0; i < dec.num_digits; ++i)
+    {
+        CHECK(digits[i] <= 9);
+        actual += static_cast<char>('0' + digits[i]);
+    }
+    CHECK(actual == expected.digits);
+    CHECK(dec.exponent == expected.exponent);
+    CHECK(dec.negative == std::signbit(value));
+
+    uint8_t bcd[schubfach::DtoaPackedBCDLength];
+    const auto dec_bcd = schubfach::DtoaPackedBCD(bcd, value);
+    CHECK(dec_bcd.num_digits == dec.num_digits);
+    CHECK(dec_bcd.exponent == dec.exponent);
+    CHECK(dec_bcd.negative == dec.negative);
+
+    std::string unpacked;
+    for (int i = 0; i < 2 * schubfach::DtoaPackedBCDLength; ++i)
+    {
+        const int nibble = (i % 2 == 0) ? (bcd[i / 2] >> 4) : (bcd[i / 2] & 0xF);
+        if (i == 2 * schubfach::DtoaPackedBCDLength - 1)
+        {
+            CHECK(nibble == (std::signbit(value) ? 0xD : 0xC));
+        }
+        else
+        {
+            CHECK(nibble <= 9);
+            unpacked += static_cast<char>('0' + nibble);
+        }
+    }
+    CHECK(unpacked == std::string(17 - dec.num_digits, '0') + actual);
+}
+
+TEST_CASE("DtoaDigits")
+{
+    CheckDtoaDigits(0.0);
+    CheckDtoaDigits(-0.0);
+    CheckDtoaDigits(1.0);
+    CheckDtoaDigits(-1.5);
+    CheckDtoaDigits(100.0);
+    CheckDtoaDigits(0.1);
+    CheckDtoaDigits(0.1 + 0.2);
+    CheckDtoaDigits(123456789.0);
+    CheckDtoaDigits(9007199254740993.0);
+    CheckDtoaDigits(std::numeric_limits<double>::min());
+    CheckDtoaDigits(std::numeric_limits<double>::denorm_min());
+    CheckDtoaDigits(-std::numeric_limits<double>::max());
+
+    uint8_t bcd[schubfach::DtoaPackedBCDLength];
+    schubfach::DtoaPackedBCD(bcd, -1234.5);
+    const uint8_t expected_bcd[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x5D};
+    CHECK(std::memcmp(bcd, expected_bcd, sizeof(expected_bcd)) == 0);
+
+    uint8_t digits[schubfach::DtoaDigitsMinBufferLength] = {0xFF};
+    CHECK(schubfach::DtoaDigits(digits, std::numeric_limits<double>::infinity()).num_digits == 0);
+    CHECK(schubfach::DtoaDigits(digits, std::numeric_limits<double>::quiet_NaN()).num_digits == 0);
+    CHECK(schubfach::DtoaPackedBCD(bcd, -std::numeric_limits<double>::infinity()).num_digits == 0);
+    CHECK(digits[0] == 0xFF);
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double value = ReinterpretBits<double>(rng());
+        if (std::isfinite(value))
+            CheckDtoaDigits(value);
+    }
+}
+
+// Returns the significant digits and the exponent (of the last digit) of the given decimal
+// number, in the form "digits'e'exponent", without leading and trailing zeros.
+static std::string NormalizedDecimal(const std::string& str)
+{
+    std::string digits;
+    int exponent = 0;
+    size_t pos = (!str.empty() && str[0] == '-') ? 1 : 0;
+    bool after_dot = false;
+    for ( ; pos < str.size() && (str[pos] == '.' || (str[pos] >= '0' && str[pos] <= '9')); ++pos)
+    {
+        if (str[pos] == '.')
+        {
+            after_dot = true;
+            continue;
+        }
+        if (after_dot)
+            --exponent;
+        if (!digits.empty() || str[pos] != '0')
+            digits.push_back(str[pos]);
+    }
+    if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E'))
+        exponent += std::atoi(str.c_str() + pos + 1);
+    while (!digits.empty() && digits.back() == '0')
+    {
+        digits.pop_back();
+        ++exponent;
+    }
+    return digits + "e" + std::to_string(exponent);
+}
+
+static void CheckDtoaShortestMaxDigits(double value, int max_digits)
+{
+    CAPTURE(value);
+    CAPTURE(max_digits);
+
+    char buf[BufSize];
+    char* end = schubfach::DtoaShortestMaxDigits(buf, value, max_digits);
+    const std::string actual(buf, end);
+
+    end = schubfach::Dtoa(buf, value);
+    const std::string shortest(buf, end);
+
+    const std::string normalized_shortest = NormalizedDecimal(shortest);
+    const int num_digits = static_cast<int>(normalized_shortest.find('e'));
+    if (num_digits <= max_digits)
+    {
+        CHECK(actual == shortest);
+    }
+    else
+    {
+        const int len = std::snprintf(buf, BufSize, "%.*e", max_digits - 1, value);
+        const std::string expected(buf, static_cast<size_t>(len));
+        CHECK(NormalizedDecimal(actual) == NormalizedDecimal(expected));
+        CHECK((actual[0] == '-') == std::signbit(value));
+    }
+}
+
+TEST_CASE("DtoaShortestMaxDigits")
+{
+    auto Str = [](double value, int max_digits) {
+        char buf[BufSize];
+        char* end = schubfach::DtoaShortestMaxDigits(buf, value, max_digits);
+        return std::string(buf, end);
+    };
+
+    CHECK(Str(0.1, 8) == "0.1");
+    CHECK(Str(0.1 + 0.2, 8) == "0.3");
+    CHECK(Str(0.1 + 0.2, 17) == "0.30000000000000004");
+    CHECK(Str(0.1 + 0.2, 16) == "0.3");
+    CHECK(Str(1.0 / 3.0, 8) == "0.33333333");
+    CHECK(Str(-2.0 / 3.0, 4) == "-0.6667");
+    CHECK(Str(123456789.0, 8) == "123456790");
+    CHECK(Str(0.125, 2) == "0.12"); // tie, exact
+    CHECK(Str(0.375, 2) == "0.38"); // tie, exact
+    CHECK(Str(2.5, 1) == "2");
+    CHECK(Str(3.5, 1) == "4");
+    CHECK(Str(9.5, 1) == "10");
+    CHECK(Str(1.005, 3) == "1"); // 1.00499999999999989...
+    CHECK(Str(1.0049999999999999, 3) == "1");
+    CHECK(Str(0.15, 1) == "0.1"); // 0.1499999999999999944...
+    CHECK(Str(0.35, 1) == "0.3"); // 0.3499999999999999778...
+    CHECK(Str(0.45, 1) == "0.5"); // 0.4500000000000000111...
+    CHECK(Str(1.5, 0) == "2");
+    CHECK(Str(1.5, -1) == "2");
+    CHECK(Str(0.0, 1) == "0");
+    CHECK(Str(-0.0, 1) == "-0");
+    CHECK(Str(std::numeric_limits<double>::infinity(), 1) == "inf");
+    CHECK(Str(std::numeric_limits<double>::quiet_NaN(), 1) == "nan");
+    CHECK(Str(std::numeric_limits<double>::max(), 3) == "1.8e+308");
+    CHECK(Str(std::numeric_limits<double>::denorm_min(), 1) == "5e-324");
+
+    for (int max_digits = 1; max_digits <= 18; ++max_digits)
+    {
+        CheckDtoaShortestMaxDigits(std::numeric_limits<double>::max(), max_digits);
+        CheckDtoaShortestMaxDigits(std::numeric_limits<double>::min(), max_digits);
+        CheckDtoaShortestMaxDigits(std::numeric_limits<double>::denorm_min(), max_digits);
+        CheckDtoaShortestMaxDigits(1.0 / 3.0, max_digits);
+    }
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 20000; ++i)
+    {
+        uint64_t bits = rng();
+        if (i % 4 == 0)
+            bits &= 0xFFF00000000000FF; // Close to powers of 2, and many exact ties.
+        if (i % 4 == 1)
+            bits &= 0xFFF0000000000000; // Powers of 2
+
+        const double value = ReinterpretBits<double>(bits);
+        if (std::isfinite(value) && value != 0)
+            CheckDtoaShortestMaxDigits(value, 1 + static_cast<int>(rng() % 17));
+    }
+}
+
+static std::string DtoaFitWidthString(double value, int width, bool fortran_style = false)
+{
+    char buf[BufSize];
+    std::memset(buf, 'x', BufSize);
+    char* end = schubfach::DtoaFitWidth(buf, value, width, fortran_style);
+    if (end == nullptr)
+    {
+        CHECK(buf[0] == 'x');
+        return "(null)";
+    }
+    return std::string(buf, end);
+}
+
+// Converts Fortran style numbers (like "1.5-3") back into C style numbers.
+static std::string FromFortranStyle(std::string str)
+{
+    const size_t pos = str.find_first_of("+-", 1);
+    if (pos != std::string::npos)
+        str.insert(pos, "e");
+    return str;
+}
+
+static void CheckDtoaFitWidth(double value, int width, bool fortran_style)
+{
+    CAPTURE(value);
+    CAPTURE(width);
+    CAPTURE(fortran_style);
+
+    const std::string str = DtoaFitWidthString(value, width, fortran_style);
+    if (str == "(null)")
+    {
+        CHECK(width < 6 + (std::signbit(value) ? 1 : 0));
+        return;
+    }
+
+    CHECK(static_cast<int>(str.size()) <= width);
+    CHECK((str[0] == '-') == std::signbit(value));
+    if (fortran_style)
+        CHECK(str.find('.') != std::string::npos);
+
+    // The output is correctly rounded.
+    const std::string normalized = NormalizedDecimal(fortran_style ? FromFortranStyle(str) : str);
+    const int num_digits = static_cast<int>(normalized.find('e'));
+
+    char buf[BufSize];
+    char* end = schubfach::Dtoa(buf, value);
+    const std::string normalized_shortest = NormalizedDecimal(std::string(buf, end));
+    const int shortest_digits = static_cast<int>(normalized_shortest.find('e'));
+    if (num_digits == shortest_digits)
+    {
+        CHECK(normalized == normalized_shortest);
+    }
+    else
+    {
+        CHECK(num_digits < shortest_digits);
+        const int len = std::snprintf(buf, BufSize, "%.*e", num_digits - 1, value);
+        CHECK(normalized == NormalizedDecimal(std::string(buf, static_cast<size_t>(len))));
+    }
+
+    // More characters never result in less precise output.
+    const std::string next = DtoaFitWidthString(value, width + 1, fortran_style);
+    const std::string normalized_next = NormalizedDecimal(fortran_style ? FromFortranStyle(next) : next);
+    CHECK(static_cast<int>(normalized_next.find('e')) >= num_digits);
+}
+
+TEST_CASE("DtoaFitWidth")
+{
+    CHECK(DtoaFitWidthString(3.14159265358979, 8) == "3.141593");
+    CHECK(DtoaFitWidthString(3.14159265358979, 4) == "3.14");
+    CHECK(DtoaFitWidthString(3.14159265358979, 2) == "3");
+    CHECK(DtoaFitWidthString(-3.14159265358979, 2) == "-3");
+    CHECK(DtoaFitWidthString(-3.14159265358979, 1) == "(null)");
+    CHECK(DtoaFitWidthString(0.1, 3) == "0.1");
+    CHECK(DtoaFitWidthString(0.1, 2) == "(null)");
+    CHECK(DtoaFitWidthString(0.1, 4) == "0.1");
+    CHECK(DtoaFitWidthString(0.001234, 8) == "0.001234");
+    CHECK(DtoaFitWidthString(0.001234, 7) == "0.00123");
+    CHECK(DtoaFitWidthString(0.001234, 6) == "0.0012");
+    CHECK(DtoaFitWidthString(0.001234, 5) == "0.001");
+    CHECK(DtoaFitWidthString(0.0001234, 7) == "1.23e-4");
+    CHECK(DtoaFitWidthString(0.001234, 4) == "1e-3");
+    CHECK(DtoaFitWidthString(0.001234, 3) == "(null)");
+    CHECK(DtoaFitWidthString(123456.0, 8) == "123456");
+    CHECK(DtoaFitWidthString(123456.0, 5) == "1.2e5");
+    CHECK(DtoaFitWidthString(123456.0, 6) == "123456");
+    CHECK(DtoaFitWidthString(1.5e+300, 8) == "1.5e300");
+    CHECK(DtoaFitWidthString(1.5e+300, 6) == "2e300");
+    CHECK(DtoaFitWidthString(1.5e-300, 8) == "1.5e-300");
+    CHECK(DtoaFitWidthString(2.5e-300, 6) == "2e-300");
+    CHECK(DtoaFitWidthString(0.0999, 3) == "0.1");
+    CHECK(DtoaFitWidthString(9.99, 2) == "10");
+    CHECK(DtoaFitWidthString(99999.9, 4) == "1e5");
+    CHECK(DtoaFitWidthString(0.0, 1) == "0");
+    CHECK(DtoaFitWidthString(-0.0, 1) == "(null)");
+    CHECK(DtoaFitWidthString(-0.0, 2) == "-0");
+    CHECK(DtoaFitWidthString(std::numeric_limits<double>::infinity(), 3) == "inf");
+    CHECK(DtoaFitWidthString(std::numeric_limits<double>::infinity(), 2) == "(null)");
+    CHECK(DtoaFitWidthString(std::numeric_limits<double>::quiet_NaN(), 3) == "nan");
+    CHECK(DtoaFitWidthString(0.1 + 0.2, 30) == "0.30000000000000004");
+
+    // Fortran style
+    CHECK(DtoaFitWidthString(3.14159265358979, 8, true) == "3.141593");
+    CHECK(DtoaFitWidthString(123456.0, 8, true) == "123456.");
+    CHECK(DtoaFitWidthString(123456.0, 6, true) == "1.23+5");
+    CHECK(DtoaFitWidthString(0.001234, 7, true) == "1.234-3");
+    CHECK(DtoaFitWidthString(-0.001234, 7, true) == "-1.23-3");
+    CHECK(DtoaFitWidthString(1.0e+10, 8, true) == "1.+10");
+    CHECK(DtoaFitWidthString(1.0e+10, 4, true) == "(null)");
+    CHECK(DtoaFitWidthString(1.0, 2, true) == "1.");
+    CHECK(DtoaFitWidthString(1.0e+300, 6, true) == "1.+300");
+    CHECK(DtoaFitWidthString(-1.2345678901e-20, 16, true) == "-1.2345678901-20");
+    CHECK(DtoaFitWidthString(-1.2345678901e-20, 8, true) == "-1.23-20");
+    CHECK(DtoaFitWidthString(0.0, 2, true) == "0.");
+    CHECK(DtoaFitWidthString(0.0, 1, true) == "(null)");
+    CHECK(DtoaFitWidthString(-0.0, 3, true) == "-0.");
+    CHECK(DtoaFitWidthString(-0.0, 2, true) == "(null)");
+    CHECK(DtoaFitWidthString(std::numeric_limits<double>::infinity(), 3, true) == "inf");
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 5000; ++i)
+    {
+        const double value = ReinterpretBits<double>(rng());
+        if (!std::isfinite(value))
+            continue;
+
+        const int width = 1 + static_cast<int>(rng() % 25);
+        CheckDtoaFitWidth(value, width, false);
+        CheckDtoaFitWidth(value, width, true);
+
+        const double value2 = static_cast<double>(rng() % 100000000) / std::pow(10.0, (rng() % 12));
+        CheckDtoaFitWidth(value2, width, false);
+        CheckDtoaFitWidth(value2, width, true);
+    }
+}
+
+// Returns the exact decimal value of the given non-negative double in normalized form (see above).
+static std::string ExactDecimal(double value)
+{
+    char buf[1024];
+    const int len = std::snprintf(buf, sizeof(buf), "%.800e", value);
+    return NormalizedDecimal(std::string(buf, static_cast<size_t>(len)));
+}
+
+// Compares two non-negative decimal numbers in normalized form.
+static int CompareNormalizedDecimals(const std::string& lhs, const std::string& rhs)
+{
+    const size_t lhs_len = lhs.find('e');
+    const size_t rhs_len = rhs.find('e');
+    if (lhs_len == 0 || rhs_len == 0)
+        return (lhs_len != 0) - (rhs_len != 0);
+
+    const int lhs_exponent = std::atoi(lhs.c_str() + lhs_len + 1) + static_cast<int>(lhs_len);
+    const int rhs_exponent = std::atoi(rhs.c_str() + rhs_len + 1) + static_cast<int>(rhs_len);
+    if (lhs_exponent != rhs_exponent)
+        return lhs_exponent < rhs_exponent ? -1 : 1;
+
+    for (size_t i = 0; i < std::max(lhs_len, rhs_len); ++i)
+    {
+        const char l = i < lhs_len ? lhs[i] : '0';
+        const char r = i < rhs_len ? rhs[i] : '0';
+        if (l != r)
+            return l < r ? -1 : 1;
+    }
+    return 0;
+}
+
+// Returns the smallest decimal number with at most the given number of significant digits, which
+// is >= lo (or > lo if !inclusive). lo must be > 0 and in normalized form.
+static std::string RoundUpSignificant(const std::string& lo, int digits, bool inclusive)
+{
+    const size_t len = lo.find('e');
+    const int exponent = std::atoi(lo.c_str() + len + 1);
+
+    std::string result = lo.substr(0, std::min(len, static_cast<size_t>(digits)));
+    const int result_exponent = exponent + static_cast<int>(len - result.size());
+    if (result.size() < len || !inclusive)
+    {
+        // Add one unit in the last place.
+        int i = static_cast<int>(result.size()) - 1;
+        while (i >= 0 && result[static_cast<size_t>(i)] == '9')
+            result[static_cast<size_t>(i--)] = '0';
+        if (i >= 0)
+            result[static_cast<size_t>(i)]++;
+        else
+            result.insert(result.begin(), '1');
+    }
+    return NormalizedDecimal(result + "e" + std::to_string(result_exponent));
+}
+
+// Returns the sum of two non-negative decimal numbers in normalized form.
+static std::string AddNormalizedDecimals(const std::string& lhs, const std::string& rhs)
+{
+    const size_t lhs_len = lhs.find('e');
+    const size_t rhs_len = rhs.find('e');
+    if (lhs_len == 0)
+        return rhs;
+    if (rhs_len == 0)
+        return lhs;
+
+    // Align both numbers to the smaller exponent and add the digits.
+    const int lhs_exponent = std::atoi(lhs.c_str() + lhs_len + 1);
+    const int rhs_exponent = std::atoi(rhs.c_str() + rhs_len + 1);
+    const int exponent = std::min(lhs_exponent, rhs_exponent);
+    const std::string l = lhs.substr(0, lhs_len) + std::string(static_cast<size_t>(lhs_exponent - exponent), '0');
+    const std::string r = rhs.substr(0, rhs_len) + std::string(static_cast<size_t>(rhs_exponent - exponent), '0');
+
+    std::string sum;
+    int carry = 0;
+    for (size_t i = 0; i < std::max(l.size(), r.size()) || carry != 0; ++i)
+    {
+        const int d = carry + (i < l.size() ? l[l.size() - 1 - i] - '0' : 0)
+                            + (i < r.size() ? r[r.size() - 1 - i] - '0' : 0);
+        sum.push_back(static_cast<char>('0' + d % 10));
+        carry = d / 10;
+    }
+    std::reverse(sum.begin(), sum.end());
+    return NormalizedDecimal(sum + "e" + std::to_string(exponent));
+}
+
+static void CheckShortestInInterval(double lo, double hi, bool inclusive)
+{
+    CAPTURE(lo);
+    CAPTURE(hi);
+    CAPTURE(inclusive);
+
+    const ryu::ShortestDecimal dec = ryu::ShortestInInterval(lo, hi, inclusive);
+    if (!dec.valid)
+    {
+        // lo == hi and lo has more than 17 significant digits.
+        CHECK(inclusive);
+        CHECK(lo == hi);
+        CHECK(ExactDecimal(lo).find('e') > 17);
+        return;
+    }
+
+    REQUIRE(dec.digits != 0);
+    CHECK(dec.digits % 10 != 0);
+    CHECK(!dec.negative);
+
+    const std::string result = std::to_string(dec.digits) + "e" + std::to_string(dec.exponent);
+    const std::string exact_lo = ExactDecimal(lo);
+    const std::string exact_hi = ExactDecimal(hi);
+
+    // The result is in the interval.
+    const int min_cmp = inclusive ? 0 : 1;
+    CHECK(CompareNormalizedDecimals(result, exact_lo) >= min_cmp);
+    CHECK(CompareNormalizedDecimals(exact_hi, result) >= min_cmp);
+
+    // There is no shorter decimal number in the interval.
+    const int num_digits = static_cast<int>(result.find('e'));
+    if (num_digits > 1 && lo > 0)
+    {
+        const std::string shorter = RoundUpSignificant(exact_lo, num_digits - 1, inclusive);
+        CHECK(CompareNormalizedDecimals(exact_hi, shorter) < min_cmp);
+    }
+
+    // No other candidate in the interval is closer to the midpoint (lo + hi) / 2, i.e. with
+    // u = 10^exponent: 2r - u <= lo + hi <= 2r + u (and r is even if one of them is an equality).
+    const std::string unit = "1e" + std::to_string(dec.exponent);
+    const std::string sum = AddNormalizedDecimals(exact_lo, exact_hi);
+    const std::string twice = AddNormalizedDecimals(result, result);
+    const bool is_even = dec.digits % 2 == 0;
+    const std::string next = NormalizedDecimal(std::to_string(dec.digits + 1) + "e" + std::to_string(dec.exponent));
+    if (CompareNormalizedDecimals(exact_hi, next) >= min_cmp)
+    {
+        const int cmp = CompareNormalizedDecimals(AddNormalizedDecimals(twice, unit), sum);
+        CHECK((cmp > 0 || (cmp == 0 && is_even)));
+    }
+    const std::string prev = NormalizedDecimal(std::to_string(dec.digits - 1) + "e" + std::to_string(dec.exponent));
+    if (dec.digits > 1 && CompareNormalizedDecimals(prev, exact_lo) >= min_cmp)
+    {
+        const int cmp = CompareNormalizedDecimals(twice, AddNormalizedDecimals(sum, unit));
+        CHECK((cmp < 0 || (cmp == 0 && is_even)));
+    }
+
+    char buf[BufSize];
+    char* end = ryu::ShortestInInterval(buf, lo, hi, inclusive);
+    REQUIRE(end != nullptr);
+    CHECK(NormalizedDecimal(std::string(buf, end)) == result);
+}
+
+TEST_CASE("ShortestInInterval")
+{
+    auto Str = [](double lo, double hi, bool inclusive) {
+        char buf[BufSize];
+        char* end = ryu::ShortestInInterval(buf, lo, hi, inclusive);
+        return end == nullptr ? std::string("(null)") : std::string(buf, end);
+    };
+
+    CHECK(Str(0.15, 0.45, true) == "0.3");
+    CHECK(Str(0.15, 0.45, false) == "0.3");
+    CHECK(Str(123.4, 123.6, true) == "123.5"); // 123.4 < double(123.4) and 123.6 > double(123.6)
+    CHECK(Str(0.5, 1.0, true) == "1");
+    CHECK(Str(0.5, 1.0, false) == "0.8"); // 0.6, 0.7, 0.8, 0.9; midpoint 0.75
+    CHECK(Str(0.16, 0.39, true) == "0.3"); // 0.2, 0.3; midpoint 0.275
+    CHECK(Str(0.11, 0.49, true) == "0.3"); // 0.2, 0.3, 0.4; midpoint 0.3
+    CHECK(Str(0.26, 0.49, true) == "0.4"); // 0.3, 0.4; midpoint 0.375
+    CHECK(Str(1001.0, 1899.0, true) == "1400"); // 1100, ..., 1800; midpoint 1450
+    CHECK(Str(1.0, 1.0, true) == "1");
+    CHECK(Str(1.0, 1.0, false) == "(null)");
+    CHECK(Str(0.1, 0.1, true) == "(null)"); // 0.1000000000000000055511151231257827...
+    CHECK(Str(0.5, 0.5, true) == "0.5");
+    CHECK(Str(1.0, std::nextafter(1.0, 2.0), true) == "1");
+    CHECK(Str(1.0, std::nextafter(1.0, 2.0), false) == "1.0000000000000001");
+    CHECK(Str(0.3, std::nextafter(0.3, 1.0), true) == "0.3");
+    CHECK(Str(std::nextafter(0.3, 1.0), std::nextafter(std::nextafter(0.3, 1.0), 1.0), true) == "0.30000000000000007");
+    CHECK(Str(4503599627370496.0, 4503599627370497.0, false) == "4503599627370496.5");
+    CHECK(Str(1234.0, 5678.0, true) == "3000");
+    CHECK(Str(1234.0, 1999.0, true) == "1600");
+    CHECK(Str(-0.45, -0.15, true) == "-0.3");
+    CHECK(Str(-1.0, -1.0, true) == "-1");
+    CHECK(Str(-0.5, 2.0, true) == "0");
+    CHECK(Str(0.0, 2.0, true) == "0");
+    CHECK(Str(0.0, 2.0, false) == "1");
+    CHECK(Str(-2.0, -0.0, true) == "0");
+    CHECK(Str(-2.0, -0.0, false) == "-1");
+    CHECK(Str(0.0, 0.0, true) == "0");
+    CHECK(Str(0.0, 0.0, false) == "(null)");
+    CHECK(Str(2.0, 1.0, true) == "(null)");
+    CHECK(Str(std::numeric_limits<double>::quiet_NaN(), 1.0, true) == "(null)");
+    CHECK(Str(0.0, std::numeric_limits<double>::infinity(), true) == "(null)");
+    CHECK(Str(0.0, std::numeric_limits<double>::denorm_min(), false) == "2e-324");
+    CHECK(Str(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), true) == "(null)");
+    CHECK(Str(1.0e+308, std::numeric_limits<double>::max(), true) == "1.4e+308"); // 1e308 < double(1e308)
+    CHECK(Str(1.5e+308, std::numeric_limits<double>::max(), false) == "1.6e+308");
+
+    const ryu::ShortestDecimal dec = ryu::ShortestInInterval(0.15, 0.45, true);
+    CHECK(dec.valid);
+    CHECK(dec.digits == 3);
+    CHECK(dec.exponent == -1);
+    CHECK(!dec.negative);
+
+    CheckShortestInInterval(std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::denorm_min(), true);
+    CheckShortestInInterval(std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), true);
+    CheckShortestInInterval(std::numeric_limits<double>::min(), std::nextafter(std::numeric_limits<double>::min(), 1.0), false);
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const double lo = std::abs(ReinterpretBits<double>(rng()));
+        if (!std::isfinite(lo))
+            continue;
+
+        // Intervals of a few ulps, and wider intervals.
+        double hi = lo;
+        for (int n = static_cast<int>(rng() % 4); n > 0; --n)
+            hi = std::nextafter(hi, std::numeric_limits<double>::infinity());
+        if (i % 2 == 0)
+            hi = lo * (1.0 + std::ldexp(static_cast<double>(rng() % 1024), -static_cast<int>(rng() % 60)));
+        if (!std::isfinite(hi))
+            continue;
+
+        CheckShortestInInterval(lo, hi, true);
+        if (lo < hi)
+            CheckShortestInInterval(lo, hi, false);
+    }
+}
+
+static std::string DtoaAsFloatString(double value)
+{
+    char buf[BufSize];
+    char* end = schubfach::DtoaAsFloat(buf, value);
+    return std::string(buf, end);
+}
+
+TEST_CASE("DtoaAsFloat")
+{
+    CHECK(DtoaAsFloatString(static_cast<double>(0.1f)) == "0.1");
+    CHECK(DtoaAsFloatString(static_cast<double>(-0.1f)) == "-0.1");
+    CHECK(DtoaAsFloatString(static_cast<double>(1.0f / 3.0f)) == "0.33333334");
+    CHECK(DtoaAsFloatString(0.1) == "0.1");
+    CHECK(DtoaAsFloatString(1.0 / 3.0) == "0.3333333333333333");
+    CHECK(DtoaAsFloatString(static_cast<double>(16777217.0f)) == "16777216");
+    CHECK(DtoaAsFloatString(16777217.0) == "16777217");
+    CHECK(DtoaAsFloatString(static_cast<double>(std::numeric_limits<float>::max())) == "3.4028235e+38");
+    CHECK(DtoaAsFloatString(static_cast<double>(std::numeric_limits<float>::denorm_min())) == "1e-45");
+    CHECK(DtoaAsFloatString(1.0e+39) == "1e+39");
+    CHECK(DtoaAsFloatString(1.0e-46) == "1e-46");
+    CHECK(DtoaAsFloatString(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+    CHECK(DtoaAsFloatString(0.0) == "0");
+    CHECK(DtoaAsFloatString(-0.0) == "-0");
+    CHECK(DtoaAsFloatString(std::numeric_limits<double>::infinity()) == "inf");
+    CHECK(DtoaAsFloatString(-std::numeric_limits<double>::infinity()) == "-inf");
+    CHECK(DtoaAsFloatString(std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+    CHECK(schubfach::IsFloatExact(0.5));
+    CHECK(schubfach::IsFloatExact(static_cast<double>(0.1f)));
+    CHECK(!schubfach::IsFloatExact(0.1));
+    CHECK(!schubfach::IsFloatExact(1.0e+39));
+    CHECK(!schubfach::IsFloatExact(-1.0e+39));
+    CHECK(!schubfach::IsFloatExact(std::numeric_limits<double>::denorm_min()));
+    CHECK(schubfach::IsFloatExact(std::numeric_limits<double>::infinity()));
+    CHECK(schubfach::IsFloatExact(std::numeric_limits<double>::quiet_NaN()));
+
+    std::mt19937 rng32;
+    std::mt19937_64 rng64;
+    std::vector<double> values;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float f = ReinterpretBits<float>(static_cast<uint32_t>(rng32()));
+        CAPTURE(f);
+
+        char buf[BufSize];
+        char* end = schubfach::Ftoa(buf, f);
+        CHECK(DtoaAsFloatString(static_cast<double>(f)) == std::string(buf, end));
+        CHECK(schubfach::IsFloatExact(static_cast<double>(f)));
+
+        const double d = ReinterpretBits<double>(rng64());
+        CAPTURE(d);
+
+        const bool exact = !std::isfinite(d) || (std::abs(d) <= std::numeric_limits<float>::max() && static_cast<double>(static_cast<float>(d)) == d);
+        CHECK(schubfach::IsFloatExact(d) == exact);
+        if (!exact)
+        {
+            end = schubfach::Dtoa(buf, d);
+            CHECK(DtoaAsFloatString(d) == std::string(buf, end));
+        }
+
+        values.push_back(static_cast<double>(f));
+    }
+
+    CHECK(schubfach::AllFloatExact(values.data(), values.size()));
+    CHECK(schubfach::AllFloatExact(values.data(), 0));
+
+    // Check each position (in the vectorized loop and in the remainder).
+    for (size_t count = 1; count <= 11; ++count)
+    {
+        for (size_t pos = 0; pos < count; ++pos)
+        {
+            CAPTURE(count);
+            CAPTURE(pos);
+
+            std::vector<double> column(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(count));
+            column[pos] = 0.1;
+            CHECK(!schubfach::AllFloatExact(column.data(), count));
+            column[pos] = 1.0e+300;
+            CHECK(!schubfach::AllFloatExact(column.data(), count));
+            column[pos] = std::numeric_limits<double>::quiet_NaN();
+            CHECK(schubfach::AllFloatExact(column.data(), count));
+            column[pos] = -std::numeric_limits<double>::infinity();
+            CHECK(schubfach::AllFloatExact(column.data(), count));
+        }
+    }
+}
+
+static std::string DtoaDirectedString(double value, bool upward)
+{
+    char buf[BufSize];
+    char* end = upward ? schubfach::DtoaCeil(buf, value) : schubfach::DtoaFloor(buf, value);
+    return std::string(buf, end);
+}
+
+static void CheckDtoaDirected(double value, bool upward)
+{
+    CAPTURE(value);
+    CAPTURE(upward);
+
+    const std::string str = DtoaDirectedString(value, upward);
+    CHECK((str[0] == '-') == std::signbit(value));
+
+    // Check the magnitude of the output against the interval [pred(|v|), |v|], or [|v|, succ(|v|)].
+    const double x = std::abs(value);
+    const bool away_from_zero = (upward != std::signbit(value));
+    const double lo = away_from_zero ? x : std::nextafter(x, 0.0);
+    const double hi = away_from_zero ? std::nextafter(x, std::numeric_limits<double>::infinity()) : x;
+    if (std::isinf(hi))
+        return;
+
+    const std::string result = NormalizedDecimal(str);
+    const std::string exact_lo = ExactDecimal(lo);
+    const std::string exact_hi = ExactDecimal(hi);
+    CHECK(CompareNormalizedDecimals(exact_lo, result) <= 0);
+    CHECK(CompareNormalizedDecimals(result, exact_hi) <= 0);
+
+    // The output is as short as possible.
+    const int num_digits = static_cast<int>(result.find('e'));
+    if (num_digits > 1 && lo > 0)
+    {
+        const std::string shorter = RoundUpSignificant(exact_lo, num_digits - 1, true);
+        CHECK(CompareNormalizedDecimals(shorter, exact_hi) > 0);
+    }
+
+    // And among the shortest numbers, the output is closest to the input.
+    if (num_digits > 0)
+    {
+        const uint64_t digits = std::stoull(result.substr(0, static_cast<size_t>(num_digits)));
+        const std::string exponent = result.substr(static_cast<size_t>(num_digits));
+        const std::string next = NormalizedDecimal(std::to_string(away_from_zero ? digits - 1 : digits + 1) + exponent);
+        if (away_from_zero)
+            CHECK(CompareNormalizedDecimals(next, exact_lo) < 0);
+        else
+            CHECK(CompareNormalizedDecimals(next, exact_hi) > 0);
+    }
+
+    // When read in, the output converts into value or its neighbor in the given direction.
+    const double parsed = std::strtod(str.c_str(), nullptr);
+    if (upward)
+        CHECK((parsed == value || parsed == std::nextafter(value, std::numeric_limits<double>::infinity())));
+    else
+        CHECK((parsed == value || parsed == std::nextafter(value, -std::numeric_limits<double>::infinity())));
+}
+
+TEST_CASE("DtoaFloor/DtoaCeil")
+{
+    CHECK(DtoaDirectedString(0.1, false) == "0.1");
+    CHECK(DtoaDirectedString(0.1, true) == "0.10000000000000001");
+    CHECK(DtoaDirectedString(-0.1, false) == "-0.10000000000000001");
+    CHECK(DtoaDirectedString(-0.1, true) == "-0.1");
+    CHECK(DtoaDirectedString(0.3, false) == "0.29999999999999998");
+    CHECK(DtoaDirectedString(0.3, true) == "0.3");
+    CHECK(DtoaDirectedString(1.0 / 3.0, false) == "0.3333333333333333");
+    CHECK(DtoaDirectedString(1.0 / 3.0, true) == "0.33333333333333332");
+    CHECK(DtoaDirectedString(1.0e+23, false) == "9.999999999999999e+22");
+    CHECK(DtoaDirectedString(1.0e+23, true) == "1e+23");
+    CHECK(DtoaDirectedString(0.5, false) == "0.5");
+    CHECK(DtoaDirectedString(0.5, true) == "0.5");
+    CHECK(DtoaDirectedString(4503599627370501.0, false) == "4503599627370500");
+    CHECK(DtoaDirectedString(4503599627370501.0, true) == "4503599627370501");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::denorm_min(), false) == "0");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::denorm_min(), true) == "5e-324");
+    CHECK(DtoaDirectedString(-std::numeric_limits<double>::denorm_min(), true) == "-0");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::max(), false) == "1.7976931348623157e+308");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::max(), true) == "1.7976931348623158e+308");
+    CHECK(DtoaDirectedString(0.0, false) == "0");
+    CHECK(DtoaDirectedString(-0.0, true) == "-0");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::infinity(), false) == "inf");
+    CHECK(DtoaDirectedString(std::numeric_limits<double>::quiet_NaN(), true) == "nan");
+
+    for (int e = -1074; e <= 1023; ++e)
+    {
+        // Powers of 2 (where the lower boundary is closer) and their neighbors.
+        const double value = std::ldexp(1.0, e);
+        CheckDtoaDirected(value, false);
+        CheckDtoaDirected(value, true);
+        CheckDtoaDirected(-value, false);
+        CheckDtoaDirected(std::nextafter(value, 0.0), true);
+    }
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 3000; ++i)
+    {
+        const double value = ReinterpretBits<double>(rng());
+        if (!std::isfinite(value) || value == 0)
+            continue;
+
+        CheckDtoaDirected(value, false);
+        CheckDtoaDirected(value, true);
+    }
+}
+
+static void CheckItoa(int64_t value)
+{
+    CAPTURE(value);
+
+    char buf[ryu::ItoaMinBufferLength];
+
+    char* end = ryu::Itoa64(buf, value);
+    CHECK(std::string(buf, end) == std::to_string(value));
+
+    if (value >= 0)
+    {
+        end = ryu::Utoa64(buf, static_cast<uint64_t>(value));
+        CHECK(std::string(buf, end) == std::to_string(value));
+    }
+
+    if (value >= INT32_MIN && value <= INT32_MAX)
+    {
+        end = ryu::Itoa32(buf, static_cast<int32_t>(value));
+        CHECK(std::string(buf, end) == std::to_string(value));
+    }
+}
+
+TEST_CASE("Itoa")
+{
+    CheckItoa(0);
+    CheckItoa(INT32_MIN);
+    CheckItoa(INT32_MAX);
+    CheckItoa(INT64_MIN);
+    CheckItoa(INT64_MAX);
+
+    // All lengths and all powers of ten.
+    int64_t p = 1;
+    for (int i = 0; i <= 18; ++i, p *= 10)
+    {
+        CheckItoa(p - 1);
+        CheckItoa(p);
+        CheckItoa(p + 1);
+        CheckItoa(-p);
+        CheckItoa(-p + 1);
+    }
+
+    char buf[ryu::ItoaMinBufferLength];
+    const uint64_t u64_values[] = {
+        UINT64_MAX, UINT64_MAX - 1, 10000000000000000000ull, 9999999999999999999ull, 10000000000000000ull, 9999999999999999ull,
+    };
+    for (const uint64_t value : u64_values)
+    {
+        char* end = ryu::Utoa64(buf, value);
+        CHECK(std::string(buf, end) == std::to_string(value));
+    }
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const uint64_t bits = rng();
+        CheckItoa(static_cast<int64_t>(bits >> (bits % 64)));
+        CheckItoa(static_cast<int64_t>(bits));
+
+        char* end = ryu::Utoa64(buf, bits);
+        CHECK(std::string(buf, end) == std::to_string(bits));
+    }
+}
+
+//==================================================================================================
+//
+//==================================================================================================
+
+TEST_CASE("Single")
+{
+    CheckSingle(MakeSingle(0,   0, 0x00000000), "0"            ); // +0
+    CheckSingle(MakeSingle(0,   0, 0x00000001), "1e-45"        ); // min denormal
+    CheckSingle(MakeSingle(0,   0, 0x007FFFFF), "1.1754942e-38"); // max denormal
+    CheckSingle(MakeSingle(0,   1, 0x00000000), "1.1754944e-38"); // min normal
+    CheckSingle(MakeSingle(0,   1, 0x00000001), "1.1754945e-38");
+    CheckSingle(MakeSingle(0,   1, 0x007FFFFF), "2.3509886e-38");
+    CheckSingle(MakeSingle(0,   2, 0x00000000), "2.3509887e-38");
+    CheckSingle(MakeSingle(0,   2, 0x00000001), "2.350989e-38" );
+    CheckSingle(MakeSingle(0,  24, 0x00000000), "9.8607613e-32"); // fail if no special case in normalized boundaries
+    CheckSingle(MakeSingle(0,  30, 0x00000000), "6.3108872e-30"); // fail if no special case in normalized boundaries
+    CheckSingle(MakeSingle(0,  31, 0x00000000), "1.2621775e-29"); // fail if no special case in normalized boundaries
+    CheckSingle(MakeSingle(0,  57, 0x00000000), "8.4703295e-22"); // fail if no special case in normalized boundaries
+    CheckSingle(MakeSingle(0, 254, 0x007FFFFE), "3.4028233e+38");
+    CheckSingle(MakeSingle(0, 254, 0x007FFFFF), "3.4028235e+38"); // max normal
+}
+
+TEST_CASE("Single - Boundaries")
+{
+    for (uint32_t e = 2; e < 254; ++e)
+    {
+        CAPTURE(e);
+        //CheckSingle(MakeSingle(0, e-1, 0x007FFFFE));
+        CheckSingle(MakeSingle(0, e-1, 0x007FFFFF));
+        CheckSingle(MakeSingle(0, e,   0x00000000));
+        //CheckSingle(MakeSingle(0, e,   0x00000001));
+        //CheckSingle(MakeSingle(0, e,   0x00000002));
+        //CheckSingle(MakeSingle(0, e,   0x002AAAAA));
+        //CheckSingle(MakeSingle(0, e,   0x00555555));
+        //CheckSingle(MakeSingle(0, e,   0x00400000));
+    }
+}
+
+TEST_CASE("Single - Paxson, Kahan")
+{
+    // V. Paxson and W. Kahan, "A Program for Testing IEEE Binary-Decimal Conversion", manuscript, May 1991,
+    // ftp://ftp.ee.lbl.gov/testbase-report.ps.Z    (report)
+    // ftp://ftp.ee.lbl.gov/testbase.tar.Z          (program)
+
+    // Table 16: Stress Inputs for Converting 24-bit Binary to Decimal, < 1/2 ULP
+    CheckSingle(MakeSingle(12676506, -102), "2.5e-24"        ); // digits  1, bits 32
+    CheckSingle(MakeSingle(12676506, -103), "1.25e-24"       ); // digits  2, bits 29
+    CheckSingle(MakeSingle(15445013,  +86), "1.195e+33"      ); // digits  3, bits 34
+    CheckSingle(MakeSingle(13734123, -138), "3.9415e-35"     ); // digits  4, bits 32
+    CheckSingle(MakeSingle(12428269, -130), "9.13085e-33"    ); // digits  5, bits 30
+    CheckSingle(MakeSingle(15334037, -146), "1.719005e-37"   ); // digits  6, bits 31
+    CheckSingle(MakeSingle(11518287,  -41), "0.0000052379105"); // digits  7, bits 30
+    CheckSingle(MakeSingle(12584953, -145), "2.821644e-37"   ); // digits  8, bits 31
+    CheckSingle(MakeSingle(15961084, -125), "3.7524328e-31"  ); // digits  9, bits 32
+    CheckSingle(MakeSingle(14915817, -146), "1.6721209e-37"  ); // digits 10, bits 31
+    CheckSingle(MakeSingle(10845484, -102), "2.1388946e-24"  ); // digits 11, bits 30
+    CheckSingle(MakeSingle(16431059,  -61), "7.125836e-12"   ); // digits 12, bits 29
+
+    // Table 17: Stress Inputs for Converting 24-bit Binary to Decimal, > 1/2 ULP
+    CheckSingle(MakeSingle(16093626,  +69), "9.5e+27"              ); // digits  1, bits 30
+    CheckSingle(MakeSingle( 9983778,  +25), "335000000000000"      ); // digits  2, bits 31
+    CheckSingle(MakeSingle(12745034, +104), "2.585e+38"            ); // digits  3, bits 31
+    CheckSingle(MakeSingle(12706553,  +72), "6.0005e+28"           ); // digits  4, bits 31
+    CheckSingle(MakeSingle(11005028,  +45), "387205000000000000000"); // digits  5, bits 30
+    CheckSingle(MakeSingle(15059547,  +71), "3.555835e+28"         ); // digits  6, bits 31
+    CheckSingle(MakeSingle(16015691,  -99), "2.5268305e-23"        ); // digits  7, bits 29
+    CheckSingle(MakeSingle( 8667859,  +56), "6.245851e+23"         ); // digits  8, bits 33
+    CheckSingle(MakeSingle(14855922,  -82), "3.0721327e-18"        ); // digits  9, bits 35
+    CheckSingle(MakeSingle(14855922,  -83), "1.5360663e-18"        ); // digits 10, bits 33
+    CheckSingle(MakeSingle(10144164, -110), "7.81478e-27"          ); // digits 11, bits 32
+    CheckSingle(MakeSingle(13248074,  +95), "5.2481028e+35"        ); // digits 12, bits 33
+}
+
+TEST_CASE("Single - Regression")
+{
+    CheckSingle(7.0385307e-26f);
+
+    CheckSingleBits(0x4C000009, "33554468");
+    CheckSingleBits(0x4C800009, "67108936");
+    CheckSingleBits(0x4D00001D, "134218190");
+    CheckSingleBits(0x4D80001D, "268436380");
+    CheckSingleBits(0x4E00001D, "536872770");
+    CheckSingleBits(0x4E80004F, "1073751900");
+    CheckSingleBits(0x4F00004F, "2147503900");
+    CheckSingleBits(0x4F80004F, "4295007700");
+    CheckSingleBits(0x50000437, "8591039000");
+    CheckSingleBits(0x50800437, "17182079000");
+    CheckSingleBits(0x51000437, "34364158000");
+    CheckSingleBits(0x51800437, "68728316000");
+    CheckSingleBits(0x52000DFB, "137497590000");
+    CheckSingleBits(0x52800DFB, "274995180000");
+    CheckSingleBits(0x53000DFB, "549990370000");
+    CheckSingleBits(0x53802665, "1100799900000");
+    CheckSingleBits(0x54002665, "2201599900000");
+    CheckSingleBits(0x54802665, "4403199700000");
+    CheckSingleBits(0x55002665, "8806399000000");
+    CheckSingleBits(0x55802665, "17612799000000");
+    CheckSingleBits(0x56002665, "35225598000000");
+    CheckSingleBits(0x56802665, "70451196000000");
+    CheckSingleBits(0x57002665, "140902390000000");
+    CheckSingleBits(0x57802665, "281804780000000");
+    CheckSingleBits(0x58002665, "563609570000000");
+    CheckSingleBits(0x58A3E9AB, "1441791900000000");
+    CheckSingleBits(0x5923E9AB, "2883583900000000");
+    CheckSingleBits(0x59A3E9AB, "5767167700000000");
+    CheckSingleBits(0x5A5F8475, "15728639000000000");
+    CheckSingleBits(0x5ADF8475, "31457279000000000");
+    CheckSingleBits(0x5B5F8475, "62914558000000000");
+    CheckSingleBits(0x5BDF8475, "125829116000000000");
+
+    CheckSingleBits(0x4D00001E, "134218200");
+    CheckSingleBits(0x4D80001E, "268436400");
+    CheckSingleBits(0x4E800050, "1073752000");
+    CheckSingleBits(0x4F800050, "4295008000");
+    CheckSingleBits(0x50000438, "8591040000");
+    CheckSingleBits(0x52000DFC, "137497600000");
+    CheckSingleBits(0x52800DFC, "274995200000");
+    CheckSingleBits(0x53802666, "1100800000000");
+    CheckSingleBits(0x54802666, "4403200000000");
+    CheckSingleBits(0x55002666, "8806400000000");
+    CheckSingleBits(0x57002666, "140902400000000");
+    CheckSingleBits(0x57802666, "281804800000000");
+    CheckSingleBits(0x58A3E9AC, "1441792000000000");
+    CheckSingleBits(0x59A3E9AC, "5767168000000000");
+    CheckSingleBits(0x5A5F8476, "15728640000000000");
+}
+
+TEST_CASE("Single - Dragonbox")
+{
+    // Shorter interval case with a tie (e2 = -35).
+    CheckSingle(MakeSingle(0, 115, 0x00000000), "2.4414062e-4");
+    // Small integers.
+    CheckSingle(16777216.0f, "16777216");
+    CheckSingle(123456.0f, "123456");
+
+    char buf0[BufSize];
+    char buf1[BufSize];
+    for (uint32_t bits = 0; bits < 0x7F800000; bits += 65521)
+    {
+        const float value = ReinterpretBits<float>(bits);
+        CAPTURE(bits);
+
+        char* end0 = dragonbox::Ftoa(buf0, value);
+        char* end1 = schubfach::Ftoa(buf1, value);
+        const auto num0 = ScanNumber(buf0, end0);
+        const auto num1 = ScanNumber(buf1, end1);
+        CHECK(num0.digits == num1.digits);
+        CHECK(num0.exponent == num1.exponent);
+    }
+}
+
+#if TEST_SINGLE_EXHAUSTIVE()
+// Checks all positive finite single-precision numbers and prints how often Grisu2 does not
+// produce the optimal output. (Takes a while...)
+TEST_CASE("Single - Grisu exhaustive")
+{
+    uint64_t not_shortest = 0;
+    uint64_t not_closest = 0;
+
+    char buf0[BufSize];
+    char buf1[BufSize];
+    for (uint32_t bits = 1; bits < 0x7F800000; ++bits)
+    {
+        const float value = ReinterpretBits<float>(bits);
+
+        char* end1 = schubfach::Ftoa(buf1, value);
+        const auto expected = ScanNumber(buf1, end1);
+
+        char* end0 = grisu3::Ftoa(buf0, value);
+        const auto actual3 = ScanNumber(buf0, end0);
+        if (actual3.digits != expected.digits || actual3.exponent != expected.exponent)
+        {
+            CAPTURE(bits);
+            CHECK(actual3.digits == expected.digits);
+            CHECK(actual3.exponent == expected.exponent);
+        }
+
+        end0 = grisu2::Ftoa(buf0, value);
+        *end0 = '\0';
+        if (ReinterpretBits<uint32_t>(std::strtof(buf0, nullptr)) != bits)
+        {
+            CAPTURE(bits);
+            FAIL("grisu2::Ftoa does not round-trip");
+        }
+
+        const auto actual2 = ScanNumber(buf0, end0);
+        if (actual2.digits.size() > expected.digits.size())
+            ++not_shortest;
+        else if (actual2.digits != expected.digits || actual2.exponent != expected.exponent)
+            ++not_closest;
+    }
+
+    printf("grisu2::Ftoa: not shortest: %llu, shortest but not closest: %llu\n",
+        static_cast<unsigned long long>(not_shortest), static_cast<unsigned long long>(not_closest));
+}
+#endif
+
+TEST_CASE("Single - Ryu")
+{
+    CheckSingleBits(0x3800000A, "0.000030517615");
+    CheckSingleBits(0x3880001E, "0.000061035375");
+    CheckSingleBits(0x390000FB, "0.00012207397");
+    CheckSingleBits(0x39800091, "0.00024414485");
+    CheckSingleBits(0x3A000024, "0.00048828335");
+    CheckSingleBits(0x3A80020F, "0.0009766239");
+    CheckSingleBits(0x3B000020, "0.0019531325");
+    CheckSingleBits(0x3B800007, "0.0039062533");
+    CheckSingleBits(0x3C800028, "0.015625075");
+    CheckSingleBits(0x3D000014, "0.031250075");
+    CheckSingleBits(0x3D80000A, "0.062500075");
+    CheckSingleBits(0x3E000032, "0.12500075");
+    CheckSingleBits(0x3E800019, "0.25000075");
+    CheckSingleBits(0x3F000024, "0.50000215");
+    CheckSingleBits(0x3F80008A, "1.0000165");
+    CheckSingleBits(0x40000045, "2.0000165");
+    CheckSingleBits(0x40800020, "4.0000153");
+    CheckSingleBits(0x418000E8, "16.000443");
+    CheckSingleBits(0x42000074, "32.000443");
+    CheckSingleBits(0x4280004A, "64.000565");
+    CheckSingleBits(0x4300003A, "128.00089");
+    CheckSingleBits(0x43800091, "256.00443");
+    CheckSingleBits(0x4400003F, "512.00385");
+    CheckSingleBits(0x448000B3, "1024.0219");
+    CheckSingleBits(0x45000111, "2048.0667");
+    CheckSingleBits(0x45800015, "4096.0103");
+
+    CheckSingleBits(0x39800000, "0.00024414062");
+    CheckSingleBits(0x3B200000, "0.0024414062");
+    CheckSingleBits(0x3B900000, "0.0043945312");
+    CheckSingleBits(0x3C880000, "0.016601562");
+    CheckSingleBits(0x3D040000, "0.032226562");
+    CheckSingleBits(0x3E020000, "0.12695312");
+    CheckSingleBits(0x3E810000, "0.25195312");
+    CheckSingleBits(0x3F808000, "1.0039062");
+    CheckSingleBits(0x40004000, "2.0039062");
+    CheckSingleBits(0x40802000, "4.0039062");
+    CheckSingleBits(0x41801000, "16.007812");
+    CheckSingleBits(0x42000800, "32.007812");
+    CheckSingleBits(0x43000400, "128.01562");
+    CheckSingleBits(0x43800200, "256.01562");
+    CheckSingleBits(0x44800100, "1024.0312");
+    CheckSingleBits(0x45000080, "2048.0312");
+    CheckSingleBits(0x45800040, "4096.0312");
+    CheckSingleBits(0x46800020, "16384.062");
+    CheckSingleBits(0x47000010, "32768.062");
+    CheckSingleBits(0x48000008, "131072.12");
+    CheckSingleBits(0x48800004, "262144.12");
+    CheckSingleBits(0x49800002, "1048576.2");
+
+    CheckSingleBits(0x4F80001E, "4294982700");
+    CheckSingleBits(0x51000002, "34359747000");
+    CheckSingleBits(0x51800142, "68722115000");
+    CheckSingleBits(0x5300016F, "549779870000");
+    CheckSingleBits(0x54801E57, "4402118700000");
+    CheckSingleBits(0x56004279, "35255747000000");
+    CheckSingleBits(0x5680DC48, "70841795000000");
+    CheckSingleBits(0x580214C8, "572103070000000");
+    CheckSingleBits(0x5984CC95, "4672454700000000");
+    CheckSingleBits(0x5B00BEFC, "36238787000000000");
+    CheckSingleBits(0x5B99C7AD, "86570435000000000");
+}
+
+TEST_CASE("Double")
+{
+    CheckDouble(MakeDouble(20, -1074), "1e-322");
+
+    CheckDouble(MakeDouble(0,    0, 0x0000000000000000), "0"                      ); // +0
+    CheckDouble(MakeDouble(0,    0, 0x0000000000000001), "5e-324"                 ); // min denormal
+    CheckDouble(MakeDouble(0,    0, 0x000FFFFFFFFFFFFF), "2.225073858507201e-308" ); // max denormal
+    CheckDouble(MakeDouble(0,    1, 0x0000000000000000), "2.2250738585072014e-308"); // min normal
+    CheckDouble(MakeDouble(0,    1, 0x0000000000000001), "2.225073858507202e-308" );
+    CheckDouble(MakeDouble(0,    1, 0x000FFFFFFFFFFFFF), "4.4501477170144023e-308");
+    CheckDouble(MakeDouble(0,    2, 0x0000000000000000), "4.450147717014403e-308" );
+    CheckDouble(MakeDouble(0,    2, 0x0000000000000001), "4.450147717014404e-308" );
+    CheckDouble(MakeDouble(0,    4, 0x0000000000000000), "1.7800590868057611e-307"); // fail if no special case in normalized boundaries
+    CheckDouble(MakeDouble(0,    5, 0x0000000000000000), "3.5601181736115222e-307"); // fail if no special case in normalized boundaries
+    CheckDouble(MakeDouble(0,    6, 0x0000000000000000), "7.120236347223045e-307" ); // fail if no special case in normalized boundaries
+    CheckDouble(MakeDouble(0,   10, 0x0000000000000000), "1.1392378155556871e-305"); // fail if no special case in normalized boundaries
+    CheckDouble(MakeDouble(0, 2046, 0x000FFFFFFFFFFFFE), "1.7976931348623155e+308");
+    CheckDouble(MakeDouble(0, 2046, 0x000FFFFFFFFFFFFF), "1.7976931348623157e+308"); // max normal
+}
+
+//inline void CheckPermutations(uint64_t e, uint64_t f)
+//{
+//    uint64_t p = next_permutation(f);
+//
+////  while (p != f && p <= 0x000FFFFFFFFFFFFF)
+//    for (int i = 0; i < 10 && p <= 0x000FFFFFFFFFFFFF; ++i)
+//    {
+//        CAPTURE(p);
+//        CheckDouble(MakeDouble(0, e, p));
+//        p = next_permutation(p);
+//    }
+//}
+
+TEST_CASE("Double - Boundaries")
+{
+    //CheckDouble(MakeDouble(0, 1080-1, 0x000FFFFFFFFFFFFF));
+
+    for (uint64_t e = 2; e < 2046; ++e)
+    {
+        CAPTURE(e);
         //CheckDouble(MakeDouble(0, e-1, 0x000FFFFFFFFFFFFE));
         CheckDouble(MakeDouble(0, e-1, 0x000FFFFFFFFFFFFF));
         CheckDouble(MakeDouble(0, e,   0x0000000000000000));
@@ -1051,6 +2499,617 @@ TEST_CASE("Double - Dragonbox regression (2)")
     CheckDouble(ReinterpretBits<double>(0x45B5C534DA985042));
 }
 
+//==================================================================================================
+//
+//==================================================================================================
+
+// Computes the shortest representation of f * 2^e using Dragon4.
+static ScanNumberResult Dragon4Shortest(uint64_t f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer)
+{
+    uint64_t digits;
+    int exponent;
+    dragon4::Dragon4(digits, exponent, f, e, accept_lower, accept_upper, lower_boundary_is_closer);
+
+    while (digits % 10 == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    return {std::to_string(digits), exponent};
+}
+
+// Computes the shortest representation for the given tie-breaking rule using Dragon4.
+static ScanNumberResult Dragon4Shortest(double value, bool accept_lower, bool accept_upper)
+{
+    const uint64_t bits = ReinterpretBits<uint64_t>(value);
+    const uint64_t F = bits & 0x000FFFFFFFFFFFFFull;
+    const uint64_t E = (bits >> 52) & 0x7FF;
+
+    const uint64_t f = (E == 0) ? F : (F | 0x0010000000000000ull);
+    const int e = (E == 0) ? -1074 : static_cast<int>(E) - 1075;
+    const bool lower_boundary_is_closer = (F == 0 && E > 1);
+
+    return Dragon4Shortest(f, e, accept_lower, accept_upper, lower_boundary_is_closer);
+}
+
+// Returns the sign of (digits * 10^exponent - value). The comparison is exact.
+static int CompareDecimal(uint64_t digits, int exponent, double value)
+{
+    const std::string str = std::to_string(digits) + "e" + std::to_string(exponent);
+
+    double lower;
+    double upper;
+    ryu::Strtod(str.data(), str.data() + str.size(), lower, ryu::RoundingMode::downward);
+    ryu::Strtod(str.data(), str.data() + str.size(), upper, ryu::RoundingMode::upward);
+
+    if (lower == upper) // exact
+        return (lower < value) ? -1 : (lower > value) ? 1 : 0;
+    return (lower >= value) ? 1 : -1;
+}
+
+// Computes the shortest representation of f * 2^e, which must be a double, using Dragon4.
+// Dragon4 returns one of the shortest representations, but not necessarily the closest one (e.g.
+// 1e-40 instead of 9e-41 for the smallest bfloat16 subnormal 9.18...e-41). This function checks
+// whether one of the neighbors with the same number of digits is closer and returns the closest
+// representation.
+static ScanNumberResult Dragon4ClosestShortest(uint64_t f, int e, bool accept_lower, bool accept_upper, bool lower_boundary_is_closer)
+{
+    uint64_t digits;
+    int exponent;
+    dragon4::Dragon4(digits, exponent, f, e, accept_lower, accept_upper, lower_boundary_is_closer);
+
+    const double value = std::ldexp(static_cast<double>(f), e);
+    const double lower_boundary = value - std::ldexp(1.0, lower_boundary_is_closer ? e - 2 : e - 1);
+    const double upper_boundary = value + std::ldexp(1.0, e - 1);
+
+    uint64_t pow10 = 1; // 10^(n-1), where n is the number of digits
+    while (digits / pow10 >= 10)
+        pow10 *= 10;
+
+    const auto in_interval = [&](uint64_t d, int x) {
+        const int cmp_lower = CompareDecimal(d, x, lower_boundary);
+        const int cmp_upper = CompareDecimal(d, x, upper_boundary);
+        return (cmp_lower > 0 || (cmp_lower == 0 && accept_lower)) && (cmp_upper < 0 || (cmp_upper == 0 && accept_upper));
+    };
+
+    // The neighbors of digits * 10^exponent with the same number of digits.
+    const uint64_t lower_digits   = (digits == pow10) ? (10 * pow10 - 1) : (digits - 1);
+    const int      lower_exponent = (digits == pow10) ? (exponent - 1) : exponent;
+    const uint64_t upper_digits   = (digits == 10 * pow10 - 1) ? pow10 : (digits + 1);
+    const int      upper_exponent = (digits == 10 * pow10 - 1) ? (exponent + 1) : exponent;
+
+    // The midpoints between digits * 10^exponent and its neighbors, scaled by 10^(exponent - 2).
+    const uint64_t lower_midpoint = (lower_exponent < exponent) ? (100 * digits + 10 * lower_digits) / 2 : 50 * (digits + lower_digits);
+    const uint64_t upper_midpoint = (upper_exponent > exponent) ? (100 * digits + 1000 * upper_digits) / 2 : 50 * (digits + upper_digits);
+
+    if (in_interval(lower_digits, lower_exponent) && CompareDecimal(lower_midpoint, exponent - 2, value) > 0)
+    {
+        digits = lower_digits;
+        exponent = lower_exponent;
+    }
+    else if (in_interval(upper_digits, upper_exponent) && CompareDecimal(upper_midpoint, exponent - 2, value) < 0)
+    {
+        digits = upper_digits;
+        exponent = upper_exponent;
+    }
+
+    while (digits % 10 == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    return {std::to_string(digits), exponent};
+}
+
+static void CheckReaderTies(double value, schubfach::ReaderTies ties)
+{
+    using Ties = schubfach::ReaderTies;
+
+    CAPTURE(value);
+    CAPTURE(static_cast<int>(ties));
+
+    const uint64_t bits = ReinterpretBits<uint64_t>(value);
+    const bool is_even = (bits & 1) == 0;
+
+    bool accept_lower = is_even;
+    bool accept_upper = is_even;
+    switch (ties)
+    {
+    case Ties::to_even:
+        break;
+    case Ties::away_from_zero:
+        accept_lower = true;
+        accept_upper = false;
+        break;
+    case Ties::toward_zero:
+        accept_lower = false;
+        accept_upper = true;
+        break;
+    case Ties::unknown:
+        accept_lower = false;
+        accept_upper = false;
+        break;
+    }
+
+    const auto expected = Dragon4Shortest(value, accept_lower, accept_upper);
+
+    char buf[BufSize];
+    char* end = buf;
+
+    switch (ties)
+    {
+    case Ties::to_even:
+        end = schubfach::Dtoa<Ties::to_even>(buf, value);
+        break;
+    case Ties::away_from_zero:
+        end = schubfach::Dtoa<Ties::away_from_zero>(buf, value);
+        break;
+    case Ties::toward_zero:
+        end = schubfach::Dtoa<Ties::toward_zero>(buf, value);
+        break;
+    case Ties::unknown:
+        end = schubfach::Dtoa<Ties::unknown>(buf, value);
+        break;
+    }
+
+    const auto num_schubfach = ScanNumber(buf, end);
+    CHECK(num_schubfach.digits == expected.digits);
+    CHECK(num_schubfach.exponent == expected.exponent);
+
+    switch (ties)
+    {
+    case Ties::to_even:
+        end = dragonbox::Dtoa<dragonbox::ReaderTies::to_even>(buf, value);
+        break;
+    case Ties::away_from_zero:
+        end = dragonbox::Dtoa<dragonbox::ReaderTies::away_from_zero>(buf, value);
+        break;
+    case Ties::toward_zero:
+        end = dragonbox::Dtoa<dragonbox::ReaderTies::toward_zero>(buf, value);
+        break;
+    case Ties::unknown:
+        end = dragonbox::Dtoa<dragonbox::ReaderTies::unknown>(buf, value);
+        break;
+    }
+
+    const auto num_dragonbox = ScanNumber(buf, end);
+    CHECK(num_dragonbox.digits == expected.digits);
+    CHECK(num_dragonbox.exponent == expected.exponent);
+}
+
+static void CheckReaderTies(double value)
+{
+    CheckReaderTies(value, schubfach::ReaderTies::to_even);
+    CheckReaderTies(value, schubfach::ReaderTies::away_from_zero);
+    CheckReaderTies(value, schubfach::ReaderTies::toward_zero);
+    CheckReaderTies(value, schubfach::ReaderTies::unknown);
+}
+
+TEST_CASE("Double - Reader ties")
+{
+    // 31322315702267410 is exactly halfway between 31322315702267408 and its
+    // successor; it only reads back correctly if ties go to even.
+    char buf[BufSize];
+    CHECK(std::string(buf, schubfach::Dtoa<schubfach::ReaderTies::to_even>(buf, 31322315702267408.0)) == "31322315702267410");
+    CHECK(std::string(buf, schubfach::Dtoa<schubfach::ReaderTies::away_from_zero>(buf, 31322315702267408.0)) == "31322315702267408");
+    CHECK(std::string(buf, schubfach::Dtoa<schubfach::ReaderTies::unknown>(buf, 31322315702267408.0)) == "31322315702267408");
+    CHECK(std::string(buf, dragonbox::Dtoa<dragonbox::ReaderTies::to_even>(buf, 31322315702267408.0)) == "31322315702267410");
+    CHECK(std::string(buf, dragonbox::Dtoa<dragonbox::ReaderTies::unknown>(buf, 31322315702267408.0)) == "31322315702267408");
+    // 25177795440463830 is the lower midpoint of 25177795440463832.
+    CHECK(std::string(buf, schubfach::Dtoa<schubfach::ReaderTies::away_from_zero>(buf, 25177795440463832.0)) == "25177795440463830");
+    CHECK(std::string(buf, schubfach::Dtoa<schubfach::ReaderTies::toward_zero>(buf, 25177795440463832.0)) == "25177795440463832");
+    CHECK(std::string(buf, dragonbox::Dtoa<dragonbox::ReaderTies::unknown>(buf, 25177795440463832.0)) == "25177795440463832");
+
+    for (uint64_t bits = 1; bits < 1000; ++bits)
+    {
+        CheckReaderTies(ReinterpretBits<double>(bits));
+    }
+
+    for (uint64_t e = 1; e < 2047; ++e)
+    {
+        CheckReaderTies(MakeDouble(0, e, 0));
+        CheckReaderTies(MakeDouble(0, e, 1));
+        CheckReaderTies(MakeDouble(0, e - 1, 0x000FFFFFFFFFFFFFull));
+    }
+
+    for (int i = 1; i < 100; ++i)
+    {
+        CheckReaderTies(static_cast<double>(i));
+        CheckReaderTies(i / 10.0);
+        CheckReaderTies(i / 100.0);
+    }
+
+    std::mt19937_64 rng(0);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t bits = 1 + rng() % (0x7FF0000000000000ull - 1);
+        CheckReaderTies(ReinterpretBits<double>(bits));
+    }
+}
+
+//==================================================================================================
+// Half, BFloat16
+//==================================================================================================
+
+// Checks the given 16-bit number (IEEE binary16 if significand_size == 11, bfloat16 if
+// significand_size == 8) against Dragon4, and checks that the output round-trips.
+template <typename ToChars, typename FromChars>
+static void CheckSmallFloat(uint16_t bits, int significand_size, int exponent_bias, ToChars to_chars, FromChars from_chars)
+{
+    CAPTURE(bits);
+
+    const uint32_t max_exponent = (0xFFFFu >> significand_size);
+    const uint32_t F = bits & ((1u << (significand_size - 1)) - 1);
+    const uint32_t E = (bits & 0x7FFF) >> (significand_size - 1);
+
+    char buf[BufSize];
+    char* end = to_chars(buf, bits);
+    const std::string str(buf, end);
+    CAPTURE(str);
+
+    if (E == max_exponent)
+    {
+        CHECK(str == (F != 0 ? "nan" : (bits & 0x8000) ? "-inf" : "inf"));
+        return;
+    }
+
+    uint16_t value = 0;
+    const auto res = from_chars(str.data(), str.data() + str.size(), value);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    CHECK(value == bits);
+
+    if (E == 0 && F == 0)
+        return;
+
+    const uint64_t f = (E == 0) ? F : (F | (1u << (significand_size - 1)));
+    const int e = (E == 0 ? 1 : static_cast<int>(E)) - exponent_bias - (significand_size - 1);
+    const bool is_even = (f % 2 == 0);
+    const auto expected = Dragon4ClosestShortest(f, e, is_even, is_even, F == 0 && E > 1);
+
+    const char* first = buf + ((bits & 0x8000) ? 1 : 0);
+    const auto actual = ScanNumber(first, end);
+    CHECK(actual.digits == expected.digits);
+    CHECK(actual.exponent == expected.exponent);
+}
+
+TEST_CASE("Half - exhaustive")
+{
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        CheckSmallFloat(static_cast<uint16_t>(bits), 11, 15, schubfach::Htoa, schubfach::Strtoh);
+    }
+
+    char buf[BufSize];
+    CHECK(std::string(buf, schubfach::Htoa(buf, 0x3C00)) == "1");
+    CHECK(std::string(buf, schubfach::Htoa(buf, 0x3555)) == "0.3333");
+    CHECK(std::string(buf, schubfach::Htoa(buf, 0x7BFF)) == "65500");
+    CHECK(std::string(buf, schubfach::Htoa(buf, 0x0001)) == "6e-8");
+    CHECK(std::string(buf, schubfach::Htoa(buf, 0x8000)) == "-0");
+}
+
+#if SCHUBFACH_HALF_TABLE
+TEST_CASE("Half - table")
+{
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        CAPTURE(bits);
+
+        char buf0[BufSize];
+        char buf1[BufSize];
+        char* end0 = schubfach::Htoa(buf0, static_cast<uint16_t>(bits));
+        char* end1 = schubfach::HtoaTable(buf1, static_cast<uint16_t>(bits));
+        CHECK(std::string(buf0, end0) == std::string(buf1, end1));
+    }
+}
+#endif
+
+TEST_CASE("BFloat16 - exhaustive")
+{
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        CheckSmallFloat(static_cast<uint16_t>(bits), 8, 127, schubfach::BF16toa, schubfach::StrtoBF16);
+    }
+
+    char buf[BufSize];
+    CHECK(std::string(buf, schubfach::BF16toa(buf, 0x3F80)) == "1");
+    CHECK(std::string(buf, schubfach::BF16toa(buf, 0x3DCD)) == "0.1");
+    CHECK(std::string(buf, schubfach::BF16toa(buf, 0x7F7F)) == "3.39e+38");
+    CHECK(std::string(buf, schubfach::BF16toa(buf, 0x0001)) == "9e-41");
+}
+
+template <typename ToChars, typename FromChars>
+static void CheckFp8(uint8_t bits, int significand_size, int exponent_bias, bool has_inf, ToChars to_chars, FromChars from_chars)
+{
+    CAPTURE(static_cast<int>(bits));
+
+    const uint32_t max_exponent = (0xFFu >> significand_size);
+    const uint32_t F = bits & ((1u << (significand_size - 1)) - 1);
+    const uint32_t E = (bits & 0x7F) >> (significand_size - 1);
+
+    char buf[BufSize];
+    char* end = to_chars(buf, bits);
+    const std::string str(buf, end);
+    CAPTURE(str);
+
+    if (has_inf ? (E == max_exponent) : ((bits & 0x7F) == 0x7F))
+    {
+        CHECK(str == (F != 0 || !has_inf ? "nan" : (bits & 0x80) ? "-inf" : "inf"));
+        return;
+    }
+
+    uint8_t value = 0;
+    const auto res = from_chars(str.data(), str.data() + str.size(), value, false);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    CHECK(value == bits);
+
+    if (E == 0 && F == 0)
+        return;
+
+    const uint64_t f = (E == 0) ? F : (F | (1u << (significand_size - 1)));
+    const int e = (E == 0 ? 1 : static_cast<int>(E)) - exponent_bias - (significand_size - 1);
+    const bool is_even = (f % 2 == 0);
+    const auto expected = Dragon4ClosestShortest(f, e, is_even, is_even, F == 0 && E > 1);
+
+    const char* first = buf + ((bits & 0x80) ? 1 : 0);
+    const auto actual = ScanNumber(first, end);
+    CHECK(actual.digits == expected.digits);
+    CHECK(actual.exponent == expected.exponent);
+}
+
+TEST_CASE("FP8 - exhaustive")
+{
+    for (uint32_t bits = 0; bits <= 0xFF; ++bits)
+    {
+        CheckFp8(static_cast<uint8_t>(bits), 4, 7, false, fp8::E4M3toa, fp8::StrtoE4M3);
+        CheckFp8(static_cast<uint8_t>(bits), 3, 15, true, fp8::E5M2toa, fp8::StrtoE5M2);
+    }
+
+    char buf[BufSize];
+    CHECK(std::string(buf, fp8::E4M3toa(buf, 0x38)) == "1");
+    CHECK(std::string(buf, fp8::E4M3toa(buf, 0x7E)) == "450");
+    CHECK(std::string(buf, fp8::E4M3toa(buf, 0xFE)) == "-450");
+    CHECK(std::string(buf, fp8::E4M3toa(buf, 0x01)) == "0.002");
+    CHECK(std::string(buf, fp8::E5M2toa(buf, 0x3C)) == "1");
+    CHECK(std::string(buf, fp8::E5M2toa(buf, 0x7B)) == "60000");
+    CHECK(std::string(buf, fp8::E5M2toa(buf, 0xFC)) == "-inf");
+
+    const uint8_t values[] = {0x38, 0xC0, 0x7F};
+    char* end = fp8::E4M3toaBatch(buf, values, 3, ',');
+    CHECK(std::string(buf, end) == "1,-2,nan");
+}
+
+TEST_CASE("Half - batch")
+{
+    const uint16_t values[] = {0x3C00, 0xC000, 0x7C00, 0x3555};
+
+    char buf[4 * schubfach::HtoaMinBufferLength];
+    char* end = schubfach::HtoaBatch(buf, values, 4, ',');
+    CHECK(std::string(buf, end) == "1,-2,inf,0.3333");
+
+    const uint16_t bf16_values[] = {0x3F80, 0xC000};
+    end = schubfach::BF16toaBatch(buf, bf16_values, 2, ';');
+    CHECK(std::string(buf, end) == "1;-2");
+}
+
+//==================================================================================================
+// Quad
+//==================================================================================================
+
+#if SCHUBFACH_FLOAT128
+
+using uint128_t = unsigned __int128;
+
+static std::string U128ToString(uint128_t value)
+{
+    std::string str;
+    do
+    {
+        str.insert(str.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+        value /= 10;
+    } while (value != 0);
+
+    return str;
+}
+
+// Checks the given binary128 number against Dragon4, and checks that the output round-trips.
+static void CheckQuad(uint128_t bits)
+{
+    CAPTURE(static_cast<uint64_t>(bits >> 64));
+    CAPTURE(static_cast<uint64_t>(bits));
+
+    const uint128_t SignMask = uint128_t{1} << 127;
+    const uint128_t HiddenBit = uint128_t{1} << 112;
+    const uint128_t F = bits & (HiddenBit - 1);
+    const uint32_t E = static_cast<uint32_t>((bits & ~SignMask) >> 112);
+
+    __float128 value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    char buf[BufSize];
+    char* end = schubfach::Qtoa(buf, value);
+    const std::string str(buf, end);
+    CAPTURE(str);
+
+    if (E == 0x7FFF)
+    {
+        CHECK(str == (F != 0 ? "nan" : (bits & SignMask) ? "-inf" : "inf"));
+        return;
+    }
+
+    __float128 parsed = 0;
+    const auto res = schubfach::Strtoq(str.data(), str.data() + str.size(), parsed);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    uint128_t parsed_bits;
+    std::memcpy(&parsed_bits, &parsed, sizeof(parsed));
+    CHECK(parsed_bits == bits);
+
+    if (E == 0 && F == 0)
+        return;
+
+    const uint128_t f = (E == 0) ? F : (F | HiddenBit);
+    const int e = (E == 0 ? 1 : static_cast<int>(E)) - 16383 - 112;
+    const bool is_even = (f % 2 == 0);
+
+    uint128_t digits;
+    int exponent;
+    dragon4::Dragon4(digits, exponent, f, e, is_even, is_even, F == 0 && E > 1);
+    while (digits % 10 == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    const char* first = buf + ((bits & SignMask) ? 1 : 0);
+    const auto actual = ScanNumber(first, end);
+    CHECK(actual.digits == U128ToString(digits));
+    CHECK(actual.exponent == exponent);
+}
+
+TEST_CASE("Quad - Dragon4")
+{
+    const uint128_t HiddenBit = uint128_t{1} << 112;
+
+    for (uint32_t E = 0; E <= 0x7FFF; E += 7)
+    {
+        const uint128_t biased_exponent = uint128_t{E} << 112;
+        CheckQuad(biased_exponent);
+        CheckQuad(biased_exponent | 1);
+        CheckQuad(biased_exponent | (HiddenBit - 1));
+    }
+    CheckQuad(uint128_t{0x7FFF} << 112);
+    CheckQuad((uint128_t{0x7FFF} << 112) | 1);
+    CheckQuad((uint128_t{0x7FFE} << 112) | (HiddenBit - 1));
+
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const uint128_t hi = rng();
+        const uint128_t bits = (hi << 64) | rng();
+        CheckQuad(bits);
+    }
+
+    __float128 p2 = 1;
+    __float128 p10 = 1;
+    for (int i = 0; i < 200; ++i)
+    {
+        uint128_t bits;
+        std::memcpy(&bits, &p2, sizeof(bits));
+        CheckQuad(bits);
+        std::memcpy(&bits, &p10, sizeof(bits));
+        CheckQuad(bits);
+        p2 *= 2;
+        p10 *= 10;
+    }
+
+    char buf[BufSize];
+    CHECK(std::string(buf, schubfach::Qtoa(buf, 1)) == "1");
+    CHECK(std::string(buf, schubfach::Qtoa(buf, -0.0)) == "-0");
+    CHECK(std::string(buf, schubfach::Qtoa(buf, __float128{1} / 10)) == "0.1");
+    CHECK(std::string(buf, schubfach::Qtoa(buf, __float128{1} / 3)) == "0.3333333333333333333333333333333333");
+    CHECK(std::string(buf, schubfach::Qtoa(buf, __float128{1} / 0.0)) == "inf");
+}
+
+#if SCHUBFACH_LONG_DOUBLE80
+
+static long double MakeLongDouble(uint32_t sign_exponent, uint64_t significand)
+{
+    const uint128_t raw = (uint128_t{sign_exponent} << 64) | significand;
+
+    long double value = 0;
+    std::memcpy(&value, &raw, 10);
+    return value;
+}
+
+// Checks the given x87 extended precision number against Dragon4, and checks that the output
+// round-trips.
+static void CheckLongDouble(uint32_t sign_exponent, uint64_t significand)
+{
+    CAPTURE(sign_exponent);
+    CAPTURE(significand);
+
+    const uint32_t E = sign_exponent & 0x7FFF;
+    const long double value = MakeLongDouble(sign_exponent, significand);
+
+    char buf[BufSize];
+    char* end = schubfach::LDtoa(buf, value);
+    const std::string str(buf, end);
+    CAPTURE(str);
+
+    long double parsed = 0;
+    const auto res = schubfach::StrtoLD(str.data(), str.data() + str.size(), parsed);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    CHECK(std::memcmp(&parsed, &value, 10) == 0);
+
+    if (significand == 0)
+        return;
+
+    const uint128_t f = significand;
+    const int e = (E == 0 ? 1 : static_cast<int>(E)) - 16383 - 63;
+    const bool is_even = (f % 2 == 0);
+
+    uint128_t digits;
+    int exponent;
+    dragon4::Dragon4(digits, exponent, f, e, is_even, is_even, significand == (uint64_t{1} << 63) && E > 1);
+    while (digits % 10 == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    const char* first = buf + ((sign_exponent & 0x8000) ? 1 : 0);
+    const auto actual = ScanNumber(first, end);
+    CHECK(actual.digits == U128ToString(digits));
+    CHECK(actual.exponent == exponent);
+}
+
+TEST_CASE("LongDouble - Dragon4")
+{
+    const uint64_t IntegerBit = uint64_t{1} << 63;
+
+    for (uint32_t E = 0; E < 0x7FFF; E += 7)
+    {
+        const uint64_t integer_bit = E != 0 ? IntegerBit : 0;
+        CheckLongDouble(E, integer_bit);
+        CheckLongDouble(E, integer_bit | 1);
+        CheckLongDouble(E | 0x8000, integer_bit | (IntegerBit - 1));
+    }
+    CheckLongDouble(0x7FFE, ~uint64_t{0});
+
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const uint32_t sign_exponent = static_cast<uint32_t>(rng() % 0xFFFF);
+        if ((sign_exponent & 0x7FFF) == 0x7FFF)
+            continue;
+        const uint64_t significand = rng();
+        CheckLongDouble(sign_exponent, (sign_exponent & 0x7FFF) != 0 ? (significand | IntegerBit) : (significand & ~IntegerBit));
+    }
+
+    char buf[BufSize];
+    CHECK(std::string(buf, schubfach::LDtoa(buf, 1.0L)) == "1");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, -0.0L)) == "-0");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, 0.1L)) == "0.1");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, 1.0L / 3)) == "0.33333333333333333334");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, std::numeric_limits<long double>::max())) == "1.189731495357231765e+4932");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, std::numeric_limits<long double>::denorm_min())) == "4e-4951");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, -std::numeric_limits<long double>::infinity())) == "-inf");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, std::numeric_limits<long double>::quiet_NaN())) == "nan");
+    // Pseudo-denormal (= the smallest normal number), unnormal, pseudo-infinity.
+    CHECK(std::string(buf, schubfach::LDtoa(buf, MakeLongDouble(0, IntegerBit))) == "3.3621031431120935063e-4932");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, MakeLongDouble(1, 1))) == "nan");
+    CHECK(std::string(buf, schubfach::LDtoa(buf, MakeLongDouble(0x7FFF, 0))) == "nan");
+}
+
+#endif // SCHUBFACH_LONG_DOUBLE80
+
+#endif // SCHUBFACH_FLOAT128
+
 #if 0
 #include <random>
 
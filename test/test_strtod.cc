@@ -1,14 +1,22 @@
 #include "catch.hpp"
 
+#include "fp8.h"
 #include "ryu_32.h"
 #include "ryu_64.h"
+#include "schubfach_16.h"
+#include "schubfach_128.h"
 
 #include "double-conversion/double-conversion.h"
 
 #include <cfloat>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <random>
+#include <string>
+#include <vector>
 
 #define TEST_LONG_INPUT() 0
 
@@ -393,6 +401,897 @@ TEST_CASE("Strtod - Boundaries")
     CheckStrtod(5708990770823839207320493820740630171355185152001e-3);
 }
 
+static double Strtod(const std::string& str, ryu::RoundingMode mode)
+{
+    double flt;
+    const auto res = ryu::Strtod(str.data(), str.data() + str.size(), flt, mode);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    return flt;
+}
+
+static void CheckStrtodRounding(const std::string& str)
+{
+    using ryu::RoundingMode;
+
+    CAPTURE(str);
+
+    const double nearest = Strtod(str, RoundingMode::nearest_even);
+    const double trunc   = Strtod(str, RoundingMode::toward_zero);
+    const double up      = Strtod(str, RoundingMode::upward);
+    const double down    = Strtod(str, RoundingMode::downward);
+
+    CHECK(down <= up);
+    CHECK((down == nearest || up == nearest));
+    CHECK((down == up || std::nextafter(down, std::numeric_limits<double>::infinity()) == up));
+    CHECK(BitsFromFloat(trunc) == BitsFromFloat(str[0] == '-' ? up : down));
+}
+
+TEST_CASE("Strtod - Rounding modes")
+{
+    using ryu::RoundingMode;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double max = std::numeric_limits<double>::max();
+    const double min = std::numeric_limits<double>::denorm_min();
+
+    // Exact inputs
+    CHECK(0.5 == Strtod("0.5", RoundingMode::upward));
+    CHECK(0.5 == Strtod("0.5", RoundingMode::downward));
+    CHECK(9007199254740992.0 == Strtod("9007199254740992", RoundingMode::upward));
+    CHECK(9007199254740992.0 == Strtod("9007199254740992", RoundingMode::downward));
+    CHECK(0.1 == Strtod("0.1000000000000000055511151231257827021181583404541015625", RoundingMode::upward));
+    CHECK(0.1 == Strtod("0.1000000000000000055511151231257827021181583404541015625", RoundingMode::downward));
+    CHECK(BitsFromFloat(-0.0) == BitsFromFloat(Strtod("-0", RoundingMode::upward)));
+
+    CHECK(0.1 == Strtod("0.1", RoundingMode::upward));
+    CHECK(std::nextafter(0.1, 0.0) == Strtod("0.1", RoundingMode::downward));
+    CHECK(std::nextafter(0.1, 0.0) == Strtod("0.1", RoundingMode::toward_zero));
+    CHECK(-0.1 == Strtod("-0.1", RoundingMode::downward));
+    CHECK(std::nextafter(-0.1, 0.0) == Strtod("-0.1", RoundingMode::upward));
+
+    CHECK(9007199254740992.0 == Strtod("9007199254740993", RoundingMode::downward));
+    CHECK(9007199254740994.0 == Strtod("9007199254740993", RoundingMode::upward));
+    CHECK(-9007199254740992.0 == Strtod("-9007199254740993", RoundingMode::upward));
+    CHECK(-9007199254740994.0 == Strtod("-9007199254740993", RoundingMode::downward));
+
+    // Long inputs
+    CHECK(0.1 == Strtod("0.10000000000000000555111512312578270211815834045410156251", RoundingMode::downward));
+    CHECK(std::nextafter(0.1, 1.0) == Strtod("0.10000000000000000555111512312578270211815834045410156251", RoundingMode::upward));
+    CHECK(std::nextafter(0.1, 0.0) == Strtod("0.10000000000000000555111512312578270211815834045410156249", RoundingMode::downward));
+    CHECK(0.1 == Strtod("0.10000000000000000555111512312578270211815834045410156249", RoundingMode::upward));
+
+    // Underflow and overflow
+    CHECK(0.0 == Strtod("1e-400", RoundingMode::downward));
+    CHECK(min == Strtod("1e-400", RoundingMode::upward));
+    CHECK(-min == Strtod("-1e-400", RoundingMode::downward));
+    CHECK(0.0 == Strtod("2.4703282292062327e-324", RoundingMode::nearest_even));
+    CHECK(min == Strtod("2.4703282292062328e-324", RoundingMode::nearest_even));
+    CHECK(min == Strtod("2.4703282292062327e-324", RoundingMode::upward));
+    CHECK(0.0 == Strtod("2.4703282292062327e-324", RoundingMode::toward_zero));
+    CHECK(max == Strtod("1e400", RoundingMode::downward));
+    CHECK(max == Strtod("1e400", RoundingMode::toward_zero));
+    CHECK(inf == Strtod("1e400", RoundingMode::upward));
+    CHECK(-inf == Strtod("-1e400", RoundingMode::downward));
+    CHECK(-max == Strtod("-1e400", RoundingMode::upward));
+    CHECK(max == Strtod("1.7976931348623158e+308", RoundingMode::downward));
+    CHECK(inf == Strtod("1.7976931348623158e+308", RoundingMode::upward));
+    CHECK(max == Strtod("1.7976931348623157e+308", RoundingMode::upward));
+    CHECK(inf == Strtod("1.797693134862315708145274237317043567981e+308", RoundingMode::upward));
+
+    CheckStrtodRounding("1");
+    CheckStrtodRounding("0.3");
+    CheckStrtodRounding("-0.3");
+    CheckStrtodRounding("1e23");
+    CheckStrtodRounding("-1e23");
+    CheckStrtodRounding("123456789012345678901234567890");
+    CheckStrtodRounding("72057594037927932");
+    CheckStrtodRounding("7205759403792793199999e-5");
+    CheckStrtodRounding("7205759403792793200001e-5");
+    CheckStrtodRounding("2.2250738585072011e-308");
+    CheckStrtodRounding("2.2250738585072012e-308");
+    CheckStrtodRounding("4.9406564584124654e-324");
+    for (int e = -330; e <= 310; ++e)
+    {
+        CheckStrtodRounding("1.2345678901234567e" + std::to_string(e));
+        CheckStrtodRounding("-7e" + std::to_string(e));
+    }
+}
+
+static void CheckCachedStrtod(const std::string& str)
+{
+    CAPTURE(str);
+
+    double expected = 0;
+    const auto expected_res = ryu::Strtod(str.data(), str.data() + str.size(), expected);
+
+    // Run twice: the first call (possibly) fills the cache, the second (possibly) hits.
+    for (int i = 0; i < 2; ++i)
+    {
+        double flt = 0;
+        const auto res = ryu::CachedStrtod(str.data(), str.data() + str.size(), flt);
+        CHECK(res.status == expected_res.status);
+        CHECK(res.next == expected_res.next);
+        if (res.status != ryu::StrtodStatus::invalid)
+        {
+            CHECK(BitsFromFloat(flt) == BitsFromFloat(expected));
+        }
+    }
+
+    // Same token, followed by more (readable) input. The trailing bytes must not affect the key.
+    for (const char* tail : {"", ",", "0", "123456789"})
+    {
+        CAPTURE(tail);
+
+        const std::string buffer = str + tail;
+        const char* first = buffer.data();
+        const char* last = first + str.size();
+
+        double flt = 0;
+        const auto res = ryu::CachedStrtod(first, last, first + buffer.size(), flt);
+        CHECK(res.status == expected_res.status);
+        CHECK(res.next - first == expected_res.next - str.data());
+        if (res.status != ryu::StrtodStatus::invalid)
+        {
+            CHECK(BitsFromFloat(flt) == BitsFromFloat(expected));
+        }
+    }
+}
+
+TEST_CASE("Strtod - Cached")
+{
+    const char* const tokens[] = {
+        "0", "1", "-1", "0.0", "-0", "100", "NaN", "-nan", "inf", "-Infinity", "1e5", "0.1",
+        "1x", "12345678", "123456789", "1.2345678", "1e400", "-1e-400", "", "-", "x", "1e",
+    };
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const char* token : tokens)
+        {
+            CheckCachedStrtod(token);
+        }
+    }
+
+    // Enough distinct tokens to cause collisions.
+    for (int i = -5000; i <= 5000; ++i)
+    {
+        CheckCachedStrtod(std::to_string(i));
+        CheckCachedStrtod(std::to_string(i) + "e-3");
+    }
+}
+
+static ryu::DecimalOrder ExpectedOrder(const std::string& str, double threshold)
+{
+    double flt = 0;
+    const auto res = ryu::Strtod(str.data(), str.data() + str.size(), flt);
+    if (res.status == ryu::StrtodStatus::invalid || res.next != str.data() + str.size())
+        return ryu::DecimalOrder::unordered;
+    if (flt < threshold)
+        return ryu::DecimalOrder::less;
+    if (flt > threshold)
+        return ryu::DecimalOrder::greater;
+    if (flt == threshold)
+        return ryu::DecimalOrder::equal;
+    return ryu::DecimalOrder::unordered;
+}
+
+static void CheckCompareDecimalText(const std::string& str, double threshold)
+{
+    CAPTURE(str);
+    CAPTURE(threshold);
+    CHECK(ryu::CompareDecimalText(str.data(), str.data() + str.size(), threshold) == ExpectedOrder(str, threshold));
+}
+
+TEST_CASE("Strtod - CompareDecimalText")
+{
+    using ryu::DecimalOrder;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double min = std::numeric_limits<double>::denorm_min();
+    const double max = std::numeric_limits<double>::max();
+
+    const double thresholds[] = {
+        0.0, -0.0, 1.0, -1.0, 100.25, -100.25, 0.1, 1e23, 1e-5, min, -min, max, -max, inf, -inf, nan,
+        9007199254740992.0, 2.2250738585072014e-308,
+    };
+
+    const char* const inputs[] = {
+        "0", "-0", "1", "-1", "100", "100.25", "100.250000000000000000000001", "-100.25", "1e3", "99.99",
+        "0.1", "0.10000000000000001", "0.09999999999999999", "1e23", "99999999999999991611392",
+        "1e-5", "1e-400", "-1e-400", "2.4703282292062328e-324", "1e400", "-1e400", "inf", "-inf", "nan",
+        "9007199254740993", "9007199254740992.5", "1.7976931348623158e308", "1.7976931348623159e308",
+        "", "-", "x", "1x", "1e", "1.", ".5", "2.2250738585072011e-308",
+        "99999999999999999999999999999999999999999999999999999999999999999999999999e-72",
+    };
+
+    for (double threshold : thresholds)
+    {
+        for (const char* input : inputs)
+        {
+            CheckCompareDecimalText(input, threshold);
+        }
+        for (int e = -330; e <= 330; e += 7)
+        {
+            CheckCompareDecimalText("1e" + std::to_string(e), threshold);
+            CheckCompareDecimalText("-9.99e" + std::to_string(e), threshold);
+        }
+    }
+
+    // Thresholds near powers of ten.
+    for (int e = -320; e <= 305; ++e)
+    {
+        const double p = Strtod("1e" + std::to_string(e));
+        for (double threshold : {p, std::nextafter(p, 0.0), std::nextafter(p, inf)})
+        {
+            CheckCompareDecimalText("1e" + std::to_string(e), threshold);
+            CheckCompareDecimalText("0.99999999999999999999e" + std::to_string(e), threshold);
+            CheckCompareDecimalText("9.99999999999999999999e" + std::to_string(e - 1), threshold);
+            CheckCompareDecimalText("1.0000000000000001e" + std::to_string(e), threshold);
+            CheckCompareDecimalText("9e" + std::to_string(e - 2), threshold);
+            CheckCompareDecimalText("1e" + std::to_string(e + 2), threshold);
+        }
+    }
+
+    // Inputs which agree with the threshold in (almost) all of the first 17 digits.
+    std::mt19937 rng;
+    std::uniform_int_distribution<uint64_t> gen;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const double threshold = FloatFromBits(gen(rng));
+        if (!std::isfinite(threshold))
+            continue;
+
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.16e", threshold);
+        const std::string str = buf;
+        const size_t e = str.find('e');
+        const std::string sign = (str[0] == '-') ? "-" : "";
+        const std::string mantissa = str.substr(sign.size(), e - sign.size());
+        const std::string exponent = str.substr(e);
+        const uint64_t digits = std::strtoull((mantissa.substr(0, 1) + mantissa.substr(2)).c_str(), nullptr, 10);
+
+        for (int k = -30; k <= 30; ++k)
+        {
+            const std::string d = std::to_string(digits + static_cast<uint64_t>(k));
+            const std::string input = sign + d.substr(0, 1) + "." + d.substr(1) + exponent;
+            CheckCompareDecimalText(input, threshold);
+            CheckCompareDecimalText(sign + d.substr(0, 1) + "." + d.substr(1) + "4999999999999999999" + exponent, threshold);
+            CheckCompareDecimalText(sign + d.substr(0, 1) + "." + d.substr(1) + "5000000000000000001" + exponent, threshold);
+        }
+
+        // The exact midpoints between the threshold and its neighbors.
+        for (double neighbor : {std::nextafter(threshold, 0.0), std::nextafter(threshold, 2 * threshold)})
+        {
+            if (!std::isfinite(neighbor))
+                continue;
+            char mid[1100];
+            std::snprintf(mid, sizeof(mid), "%.800e", threshold / 2 + neighbor / 2);
+            CheckCompareDecimalText(mid, threshold);
+        }
+    }
+
+    const std::string buffer = "1,100.25,-3,abc,,1e5,100.2500000000000001";
+    DecimalOrder results[8];
+    const size_t count = ryu::CompareDecimalTextBatch(buffer.data(), buffer.data() + buffer.size(), ',', 100.25, results, 8);
+    REQUIRE(count == 7);
+    CHECK(results[0] == DecimalOrder::less);
+    CHECK(results[1] == DecimalOrder::equal);
+    CHECK(results[2] == DecimalOrder::less);
+    CHECK(results[3] == DecimalOrder::unordered);
+    CHECK(results[4] == DecimalOrder::unordered);
+    CHECK(results[5] == DecimalOrder::greater);
+    CHECK(results[6] == DecimalOrder::equal);
+
+    CHECK(ryu::CompareDecimalTextBatch(buffer.data(), buffer.data() + buffer.size(), ',', 100.25, results, 2) == 2);
+    CHECK(ryu::CompareDecimalTextBatch(buffer.data(), buffer.data(), ',', 100.25, results, 8) == 0);
+
+    // Line breaks separate tokens, and spaces, tabs and '\r' are removed.
+    const std::string lines = " 100.25 ,\t1e3\r\n-1\n";
+    REQUIRE(ryu::CompareDecimalTextBatch(lines.data(), lines.data() + lines.size(), ',', 100.25, results, 8) == 3);
+    CHECK(results[0] == DecimalOrder::equal);
+    CHECK(results[1] == DecimalOrder::greater);
+    CHECK(results[2] == DecimalOrder::less);
+}
+
+// Reference implementation for FindTokens.
+static std::vector<std::string> SplitTokens(const std::string& str, char delimiter)
+{
+    std::vector<std::string> tokens;
+    if (str.empty())
+        return tokens;
+
+    const auto is_space = [](char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; };
+
+    size_t pos = 0;
+    for (;;)
+    {
+        size_t end = pos;
+        while (end < str.size() && str[end] != delimiter && str[end] != '\n')
+            ++end;
+
+        if (end == str.size() && pos == end && str.back() == '\n')
+            break;
+
+        size_t f = pos;
+        size_t l = end;
+        while (f < l && is_space(str[f]))
+            ++f;
+        while (f < l && is_space(str[l - 1]))
+            --l;
+        tokens.push_back(str.substr(f, l - f));
+
+        if (end == str.size())
+            break;
+        pos = end + 1;
+    }
+
+    return tokens;
+}
+
+static void CheckFindTokens(const std::string& str, char delimiter)
+{
+    CAPTURE(str);
+
+    const auto expected = SplitTokens(str, delimiter);
+
+    std::vector<ryu::TokenSpan> spans(expected.size() + 1);
+    const size_t count = ryu::FindTokens(str.data(), str.data() + str.size(), delimiter, spans.data(), spans.size());
+    REQUIRE(count == expected.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        CHECK(std::string(spans[i].first, spans[i].last) == expected[i]);
+    }
+
+    std::vector<std::string> tokens;
+    ryu::ForEachToken(str.data(), str.data() + str.size(), delimiter, [](void* context, const char* first, const char* last) {
+        static_cast<std::vector<std::string>*>(context)->emplace_back(first, last);
+        return true;
+    }, &tokens);
+    CHECK(tokens == expected);
+
+    std::vector<double> values(expected.size() + 1);
+    REQUIRE(ryu::StrtodBatch(str.data(), str.data() + str.size(), delimiter, values.data(), values.size()) == count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        double flt = 0;
+        const auto& token = expected[i];
+        const auto res = ryu::Strtod(token.data(), token.data() + token.size(), flt);
+        if (res.status == ryu::StrtodStatus::invalid || res.next != token.data() + token.size())
+            CHECK(std::isnan(values[i]));
+        else
+            CHECK(BitsFromFloat(values[i]) == BitsFromFloat(flt));
+    }
+}
+
+TEST_CASE("Strtod - StrtodBatch")
+{
+    CheckFindTokens("", ',');
+    CheckFindTokens(",", ',');
+    CheckFindTokens("\n", ',');
+    CheckFindTokens("1", ',');
+    CheckFindTokens("1,", ',');
+    CheckFindTokens("1\n", ',');
+    CheckFindTokens("1,2\n3,4\n", ',');
+    CheckFindTokens("1,2\r\n3,4\r\n", ',');
+    CheckFindTokens(" 1 ,\t-2.5e3 , abc,,inf,nan, 1x \n", ',');
+    CheckFindTokens("1;2;3", ';');
+    CheckFindTokens("1\t2\t3", '\t');
+
+    std::mt19937 rng;
+    std::uniform_int_distribution<uint64_t> gen;
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string str;
+        const int num = static_cast<int>(rng() % 100);
+        for (int k = 0; k < num; ++k)
+        {
+            char buf[64];
+            char* end = ryu::Dtoa(buf, FloatFromBits(gen(rng)));
+            str.append(buf, end);
+            str += (rng() % 8 == 0) ? '\n' : ',';
+        }
+        CheckFindTokens(str, ',');
+        CheckFindTokens(str + "12345", ',');
+    }
+
+    // Stop at max_values.
+    const std::string str = "1,2,3,4";
+    double values[2];
+    REQUIRE(ryu::StrtodBatch(str.data(), str.data() + str.size(), ',', values, 2) == 2);
+    CHECK(values[0] == 1.0);
+    CHECK(values[1] == 2.0);
+
+    // Stop when the callback returns false.
+    int num_calls = 0;
+    ryu::ForEachToken(str.data(), str.data() + str.size(), ',', [](void* context, const char*, const char*) {
+        return ++*static_cast<int*>(context) < 3;
+    }, &num_calls);
+    CHECK(num_calls == 3);
+}
+
+
+static bool Atoi64(const std::string& str, int64_t& value, size_t expected_length)
+{
+    const auto res = ryu::Atoi64(str.data(), str.data() + str.size(), value);
+    if (res.status == ryu::StrtodStatus::invalid)
+    {
+        CHECK(res.next == str.data());
+        return false;
+    }
+
+    CHECK(res.status == ryu::StrtodStatus::integer);
+    CHECK(res.next == str.data() + expected_length);
+    return true;
+}
+
+static int64_t Atoi64(const std::string& str)
+{
+    CAPTURE(str);
+
+    int64_t value = 0;
+    CHECK(Atoi64(str, value, str.size()));
+    return value;
+}
+
+static bool Atoi64Fails(const std::string& str)
+{
+    CAPTURE(str);
+
+    int64_t value = 12345;
+    const bool ok = Atoi64(str, value, str.size());
+    CHECK(value == 12345); // unchanged
+    return !ok;
+}
+
+TEST_CASE("Atoi64")
+{
+    CHECK(Atoi64("0") == 0);
+    CHECK(Atoi64("-0") == 0);
+    CHECK(Atoi64("+0") == 0);
+    CHECK(Atoi64("1") == 1);
+    CHECK(Atoi64("-1") == -1);
+    CHECK(Atoi64("12345678") == 12345678);
+    CHECK(Atoi64("123456789") == 123456789);
+    CHECK(Atoi64("1234567812345678") == 1234567812345678);
+    CHECK(Atoi64("00000000000000000000000000001") == 1);
+    CHECK(Atoi64("-00000000000000000000009223372036854775808") == INT64_MIN);
+    CHECK(Atoi64("9223372036854775807") == INT64_MAX);
+    CHECK(Atoi64("-9223372036854775808") == INT64_MIN);
+    CHECK(Atoi64("-9223372036854775807") == -INT64_MAX);
+
+    CHECK(Atoi64Fails(""));
+    CHECK(Atoi64Fails("-"));
+    CHECK(Atoi64Fails("+"));
+    CHECK(Atoi64Fails("x"));
+    CHECK(Atoi64Fails("-x"));
+    CHECK(Atoi64Fails(" 1"));
+    CHECK(Atoi64Fails("9223372036854775808"));
+    CHECK(Atoi64Fails("-9223372036854775809"));
+    CHECK(Atoi64Fails("18446744073709551615"));
+    CHECK(Atoi64Fails("18446744073709551616"));
+    CHECK(Atoi64Fails("99999999999999999999"));
+    CHECK(Atoi64Fails("100000000000000000000"));
+
+    // Stops at the first non-digit, at any position relative to the 8-digit blocks.
+    for (int n = 1; n <= 18; ++n)
+    {
+        const std::string digits = std::string("123456789012345678").substr(0, static_cast<size_t>(n));
+        for (const char* suffix : {".5", "e1", ",", "x1234567890", " 12345678"})
+        {
+            const std::string str = digits + suffix;
+            CAPTURE(str);
+
+            int64_t value = 0;
+            CHECK(Atoi64(str, value, digits.size()));
+            CHECK(value == std::strtoll(digits.c_str(), nullptr, 10));
+        }
+    }
+
+    std::mt19937_64 rng;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const uint64_t bits = rng();
+        const int64_t magnitude = static_cast<int64_t>(bits >> (1 + bits % 63));
+        const int64_t expected = (bits & 1) ? -magnitude : magnitude;
+        CHECK(Atoi64(std::to_string(expected)) == expected);
+    }
+}
+
+// All rounding modes, for tests which check each of them.
+static constexpr ryu::DecimalRounding AllDecimalRoundings[] = {
+    ryu::DecimalRounding::half_away_from_zero,
+    ryu::DecimalRounding::half_even,
+    ryu::DecimalRounding::toward_zero,
+    ryu::DecimalRounding::upward,
+    ryu::DecimalRounding::downward,
+};
+
+static double StrtodRounded(const std::string& str, int decimals, ryu::DecimalRounding mode = ryu::DecimalRounding::half_away_from_zero)
+{
+    double flt = -1.0;
+    const auto res = ryu::StrtodRounded(str.data(), str.data() + str.size(), decimals, flt, mode);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return flt;
+}
+
+static void CheckStrtodRounded(const std::string& str)
+{
+    using ryu::DecimalRounding;
+
+    CAPTURE(str);
+    for (const DecimalRounding mode : AllDecimalRoundings)
+    {
+        for (const int decimals : {-1001, -310, -20, -3, -2, -1, 0, 1, 2, 3, 4, 6, 8, 10, 14, 15, 16, 17, 20, 300, 306, 307, 308, 310, 320, 330, 1001})
+        {
+            const double value = StrtodRounded(str, decimals, mode);
+            const double expected = ryu::Round10(Strtod(str), -decimals, mode);
+            if (BitsFromFloat(value) != BitsFromFloat(expected) && !(std::isnan(value) && std::isnan(expected)))
+            {
+                CAPTURE(static_cast<int>(mode));
+                CAPTURE(decimals);
+                CAPTURE(value);
+                CAPTURE(expected);
+                CHECK(false);
+            }
+        }
+    }
+}
+
+TEST_CASE("StrtodRounded")
+{
+    using ryu::DecimalRounding;
+
+    CHECK(StrtodRounded("12.3456789", 4) == 12.3457);
+    CHECK(StrtodRounded("-12.3456789", 4) == -12.3457);
+    CHECK(StrtodRounded("12.34565", 4) == 12.3457);
+    CHECK(StrtodRounded("12.34565", 4, DecimalRounding::half_even) == 12.3456);
+    CHECK(StrtodRounded("12.34565", 4, DecimalRounding::downward) == 12.3456);
+    CHECK(StrtodRounded("1.005", 2) == 1.01);
+    CHECK(StrtodRounded("55", -1) == 60.0);
+    CHECK(StrtodRounded("0.001", 2) == 0.0);
+    CHECK(std::signbit(StrtodRounded("-0.001", 2)));
+    CHECK(StrtodRounded("1.23e2", 0) == 123.0);
+    CHECK(StrtodRounded("123.4500000000000000000000000", 1) == 123.5);
+    CHECK(StrtodRounded("0.000000000000000000000000000000000001234", 38) == 1.23e-36);
+    CHECK(StrtodRounded("inf", 2) == std::numeric_limits<double>::infinity());
+    CHECK(std::isnan(StrtodRounded("nan", 2)));
+
+    const std::string invalid = "x";
+    double flt = -1.0;
+    CHECK(ryu::StrtodRounded(invalid.data(), invalid.data() + invalid.size(), 2, flt).status == ryu::StrtodStatus::invalid);
+    CHECK(flt == -1.0);
+
+    for (const char* str : {
+        "0", "-0", "0.0", "0.00", "1", "-1", "0.5", "1.5", "2.5", "0.05", "0.005", "0.015", "0.025",
+        "2.675", "2.665", "1.005", "0.1", "0.30000000000000004", "123456789012345", "1234567890123456",
+        "12345678901234567", "123456789012345678", "1234567890123456789", "12345678901234567890",
+        "9999999999999999", "99999999999999999", "0.99999999999999999", "1e-300", "1.5e-306",
+        "1.5e-307", "1.5e-308", "2.2250738585072014e-308", "2.225073858507201e-308", "4.9e-324",
+        "1e-320", "1.7976931348623157e308", "1.8e308", "1e308", "9.999e307", "1e309", "1e-400",
+        "1.000000000000000000000000000000000000001", "0.000001234500000000000000",
+        "1234.5000000000000000000000000000000000000000001",
+    })
+    {
+        CheckStrtodRounded(str);
+    }
+
+    std::mt19937_64 rng;
+    char buf[64];
+    for (int i = 0; i < 300; ++i)
+    {
+        const int len = std::snprintf(buf, sizeof(buf), "%.*e", static_cast<int>(rng() % 19), FloatFromBits(rng() & 0x7FEFFFFFFFFFFFFF));
+        CheckStrtodRounded(std::string(buf, static_cast<size_t>(len)));
+
+        const int len2 = std::snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(rng() % 10), static_cast<double>(rng() % 100000000) / 1000);
+        CheckStrtodRounded(std::string(buf, static_cast<size_t>(len2)));
+    }
+}
+
+static uint16_t Strtoh(const std::string& str)
+{
+    uint16_t value = 0;
+    const auto res = schubfach::Strtoh(str.data(), str.data() + str.size(), value);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return value;
+}
+
+static uint16_t StrtoBF16(const std::string& str)
+{
+    uint16_t value = 0;
+    const auto res = schubfach::StrtoBF16(str.data(), str.data() + str.size(), value);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return value;
+}
+
+TEST_CASE("Strtoh")
+{
+    CHECK(Strtoh("0") == 0x0000);
+    CHECK(Strtoh("-0") == 0x8000);
+    CHECK(Strtoh("1") == 0x3C00);
+    CHECK(Strtoh("-2") == 0xC000);
+    CHECK(Strtoh("inf") == 0x7C00);
+    CHECK(Strtoh("-inf") == 0xFC00);
+    CHECK(Strtoh("nan") == 0x7E00);
+    CHECK(Strtoh("65504") == 0x7BFF);
+    CHECK(Strtoh("65519.999") == 0x7BFF);
+    CHECK(Strtoh("65520") == 0x7C00); // tie, rounds to even (= inf)
+    CHECK(Strtoh("1e10") == 0x7C00);
+    CHECK(Strtoh("-1e10") == 0xFC00);
+
+    // 2049 is the midpoint between 2048 and 2050.
+    CHECK(Strtoh("2049") == 0x6800);
+    CHECK(Strtoh("2051") == 0x6802);
+    CHECK(Strtoh("2048.9999999") == 0x6800);
+    CHECK(Strtoh("2049.0000001") == 0x6801);
+    // Rounding to double first would produce 2049 here, which would then round to 2048.
+    CHECK(Strtoh("2049.00000000000000000001") == 0x6801);
+    CHECK(Strtoh("-2049.00000000000000000001") == 0xE801);
+
+    // 2^-25 is the midpoint between 0 and the smallest subnormal.
+    CHECK(Strtoh("2.98023223876953125e-8") == 0x0000);
+    CHECK(Strtoh("2.98023223876953125000001e-8") == 0x0001);
+    CHECK(Strtoh("5.960464477539063e-8") == 0x0001);
+    CHECK(Strtoh("1e-30") == 0x0000);
+    CHECK(Strtoh("-1e-30") == 0x8000);
+    CHECK(Strtoh("6.1035156e-5") == 0x0400); // smallest normal
+
+    uint16_t value = 0;
+    const std::string invalid = "abc";
+    CHECK(schubfach::Strtoh(invalid.data(), invalid.data() + invalid.size(), value).status == ryu::StrtodStatus::invalid);
+}
+
+TEST_CASE("StrtoBF16")
+{
+    CHECK(StrtoBF16("1") == 0x3F80);
+    CHECK(StrtoBF16("-2") == 0xC000);
+    CHECK(StrtoBF16("inf") == 0x7F80);
+    CHECK(StrtoBF16("nan") == 0x7FC0);
+    CHECK(StrtoBF16("3.3895314e38") == 0x7F7F);
+    CHECK(StrtoBF16("3.40e38") == 0x7F80);
+
+    // 257 is the midpoint between 256 and 258.
+    CHECK(StrtoBF16("257") == 0x4380);
+    CHECK(StrtoBF16("259") == 0x4382);
+    CHECK(StrtoBF16("257.00000000000000000001") == 0x4381);
+
+    CHECK(StrtoBF16("1e-45") == 0x0000);
+    CHECK(StrtoBF16("9.2e-41") == 0x0001);
+}
+
+TEST_CASE("Strtoh - batch")
+{
+    const std::string str = "1, -2, inf, abc,\n0.1,";
+    uint16_t values[8];
+    REQUIRE(schubfach::StrtohBatch(str.data(), str.data() + str.size(), ',', values, 8) == 7);
+    CHECK(values[0] == 0x3C00);
+    CHECK(values[1] == 0xC000);
+    CHECK(values[2] == 0x7C00);
+    CHECK(values[3] == 0x7E00);
+    CHECK(values[4] == 0x7E00);
+    CHECK(values[5] == 0x2E66);
+    CHECK(values[6] == 0x7E00);
+
+    // More tokens than fit into a single chunk.
+    std::string many;
+    for (int i = 0; i < 1000; ++i)
+        many += std::to_string(i) + (i % 10 == 9 ? "\n" : ",");
+
+    std::vector<uint16_t> bf16(1001);
+    REQUIRE(schubfach::StrtoBF16Batch(many.data(), many.data() + many.size(), ',', bf16.data(), bf16.size()) == 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        CHECK(bf16[static_cast<size_t>(i)] == StrtoBF16(std::to_string(i)));
+    }
+    REQUIRE(schubfach::StrtoBF16Batch(many.data(), many.data() + many.size(), ',', bf16.data(), 300) == 300);
+
+    // A trailing empty token after a full chunk of tokens.
+    std::string full;
+    for (int i = 0; i < 256; ++i)
+        full += "1,";
+
+    std::vector<uint16_t> half(300);
+    REQUIRE(schubfach::StrtohBatch(full.data(), full.data() + full.size(), ',', half.data(), half.size()) == 257);
+    CHECK(half[255] == 0x3C00);
+    CHECK(half[256] == 0x7E00);
+}
+
+#if SCHUBFACH_FLOAT128
+
+using uint128_t = unsigned __int128;
+
+static uint128_t MakeU128(uint64_t hi, uint64_t lo)
+{
+    return (uint128_t{hi} << 64) | lo;
+}
+
+static uint128_t Strtoq(const std::string& str)
+{
+    __float128 value = 0;
+    const auto res = schubfach::Strtoq(str.data(), str.data() + str.size(), value);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+
+    uint128_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+TEST_CASE("Strtoq")
+{
+    CHECK(Strtoq("0") == MakeU128(0x0000000000000000, 0));
+    CHECK(Strtoq("-0") == MakeU128(0x8000000000000000, 0));
+    CHECK(Strtoq("1") == MakeU128(0x3FFF000000000000, 0));
+    CHECK(Strtoq("-2") == MakeU128(0xC000000000000000, 0));
+    CHECK(Strtoq("0.1") == MakeU128(0x3FFB999999999999, 0x999999999999999A));
+    CHECK(Strtoq("0.1" + std::string(100, '0') + "1") == MakeU128(0x3FFB999999999999, 0x999999999999999A));
+    CHECK(Strtoq("12345678901234567890123456789012345678901234567890") == MakeU128(0x40A20E4FEC6D355F, 0x07942A04CE8F5F19));
+    CHECK(Strtoq("inf") == MakeU128(0x7FFF000000000000, 0));
+    CHECK(Strtoq("-Infinity") == MakeU128(0xFFFF000000000000, 0));
+    CHECK(Strtoq("nan") == MakeU128(0x7FFF800000000000, 0));
+    CHECK(Strtoq("nan(123)") == MakeU128(0x7FFF800000000000, 0));
+
+    // 1 + 2^-113 is the midpoint between 1 and 1 + 2^-112.
+    const std::string half_ulp = "1.00000000000000000000000000000000009629649721936179265279889712924636592690508241076940976199693977832794189453125";
+    CHECK(Strtoq(half_ulp) == MakeU128(0x3FFF000000000000, 0));
+    CHECK(Strtoq(half_ulp + "1") == MakeU128(0x3FFF000000000000, 1));
+    // 1 + 3 * 2^-113 is the midpoint between 1 + 2^-112 and 1 + 2^-111.
+    CHECK(Strtoq("1.00000000000000000000000000000000028888949165808537795839669138773909778071524723230822928599081933498382568359375") == MakeU128(0x3FFF000000000000, 2));
+
+    // Largest finite number.
+    CHECK(Strtoq("1.189731495357231765085759326628007e4932") == MakeU128(0x7FFEFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF));
+    CHECK(Strtoq("1.18973149535723176508575932662800702e4932") == MakeU128(0x7FFEFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF));
+    CHECK(Strtoq("1.18973149535723176508575932662800703e4932") == MakeU128(0x7FFEFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF));
+    CHECK(Strtoq("1.2e4932") == MakeU128(0x7FFF000000000000, 0));
+
+    // Smallest normal and subnormal numbers.
+    CHECK(Strtoq("3.3621031431120935062626778173217526e-4932") == MakeU128(0x0001000000000000, 0));
+    CHECK(Strtoq("6.475175119438025110924438958227646552e-4966") == MakeU128(0, 1));
+    CHECK(Strtoq("3.2375875597190126e-4966") == MakeU128(0, 1));
+    CHECK(Strtoq("3.2375875597190125e-4966") == MakeU128(0, 0));
+    CHECK(Strtoq("1e-4966") == MakeU128(0, 0));
+
+    __float128 value = 0;
+    for (const std::string invalid : {"", "-", ".", "e5", "abc"})
+    {
+        CAPTURE(invalid);
+        CHECK(schubfach::Strtoq(invalid.data(), invalid.data() + invalid.size(), value).status == ryu::StrtodStatus::invalid);
+    }
+
+    // The parser stops at the same position as ryu::Strtod.
+    for (const std::string str : {"1e", "1e+", "2.5x", "0x10"})
+    {
+        CAPTURE(str);
+        double d = 0;
+        const auto res_d = ryu::Strtod(str.data(), str.data() + str.size(), d);
+        const auto res_q = schubfach::Strtoq(str.data(), str.data() + str.size(), value);
+        CHECK(res_q.status == res_d.status);
+        CHECK(res_q.next == res_d.next);
+        CHECK(static_cast<double>(value) == d);
+    }
+}
+
+#if SCHUBFACH_LONG_DOUBLE80
+
+static long double StrtoLD(const std::string& str)
+{
+    long double value = 0;
+    const auto res = schubfach::StrtoLD(str.data(), str.data() + str.size(), value);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return value;
+}
+
+TEST_CASE("StrtoLD")
+{
+    CHECK(StrtoLD("0") == 0.0L);
+    CHECK(std::signbit(StrtoLD("-0")));
+    CHECK(StrtoLD("1") == 1.0L);
+    CHECK(StrtoLD("-2") == -2.0L);
+    CHECK(StrtoLD("0.1") == 0.1L);
+    CHECK(StrtoLD("0.1" + std::string(100, '0') + "1") == 0.1L);
+    CHECK(StrtoLD("1.189731495357231765e+4932") == LDBL_MAX);
+    CHECK(StrtoLD("1.2e4932") == HUGE_VALL);
+    CHECK(StrtoLD("-Infinity") == -HUGE_VALL);
+    CHECK(std::isnan(StrtoLD("nan")));
+    CHECK(StrtoLD("3.3621031431120935063e-4932") == LDBL_MIN);
+    CHECK(StrtoLD("4e-4951") == LDBL_TRUE_MIN);
+    CHECK(StrtoLD("1e-4952") == 0.0L);
+
+    // 2^64 + 1 is the midpoint between 2^64 and 2^64 + 2.
+    CHECK(StrtoLD("18446744073709551617") == 18446744073709551616.0L);
+    CHECK(StrtoLD("18446744073709551617.000000000000000000000000000001") == 18446744073709551618.0L);
+    CHECK(StrtoLD("18446744073709551619") == 18446744073709551620.0L);
+
+    // The results agree with strtold.
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string str = std::to_string(rng()) + "e" + std::to_string(static_cast<int>(rng() % 9900) - 4960);
+        CAPTURE(str);
+        const long double expected = std::strtold(str.c_str(), nullptr);
+        CHECK(StrtoLD(str) == expected);
+    }
+
+    long double value = 0;
+    for (const std::string invalid : {"", "-", ".", "e5", "abc"})
+    {
+        CAPTURE(invalid);
+        CHECK(schubfach::StrtoLD(invalid.data(), invalid.data() + invalid.size(), value).status == ryu::StrtodStatus::invalid);
+    }
+}
+
+#endif // SCHUBFACH_LONG_DOUBLE80
+
+#endif // SCHUBFACH_FLOAT128
+
+static int StrtoE4M3(const std::string& str, bool saturate = false)
+{
+    uint8_t value = 0;
+    const auto res = fp8::StrtoE4M3(str.data(), str.data() + str.size(), value, saturate);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return value;
+}
+
+static int StrtoE5M2(const std::string& str, bool saturate = false)
+{
+    uint8_t value = 0;
+    const auto res = fp8::StrtoE5M2(str.data(), str.data() + str.size(), value, saturate);
+    CHECK(res.status != ryu::StrtodStatus::invalid);
+    CHECK(res.next == str.data() + str.size());
+    return value;
+}
+
+TEST_CASE("StrtoE4M3, StrtoE5M2")
+{
+    CHECK(StrtoE4M3("1") == 0x38);
+    CHECK(StrtoE4M3("-0") == 0x80);
+    CHECK(StrtoE4M3("448") == 0x7E);
+    CHECK(StrtoE4M3("464") == 0x7E); // tie, rounds to even
+    CHECK(StrtoE4M3("464.00000000000000000001") == 0x7F);
+    CHECK(StrtoE4M3("464.00000000000000000001", true) == 0x7E);
+    CHECK(StrtoE4M3("-1e10") == 0xFF);
+    CHECK(StrtoE4M3("-1e10", true) == 0xFE);
+    CHECK(StrtoE4M3("inf") == 0x7F);
+    CHECK(StrtoE4M3("inf", true) == 0x7E);
+    CHECK(StrtoE4M3("nan") == 0x7F);
+    CHECK(StrtoE4M3("nan", true) == 0x7F);
+    // 1.0625 is the midpoint between 1 and 1.125.
+    CHECK(StrtoE4M3("1.0625") == 0x38);
+    CHECK(StrtoE4M3("1.06250000000000000001") == 0x39);
+    // 2^-10 is the midpoint between 0 and the smallest subnormal.
+    CHECK(StrtoE4M3("0.0009765625") == 0x00);
+    CHECK(StrtoE4M3("0.00097656250000000000001") == 0x01);
+
+    CHECK(StrtoE5M2("1") == 0x3C);
+    CHECK(StrtoE5M2("57344") == 0x7B);
+    CHECK(StrtoE5M2("61439") == 0x7B);
+    CHECK(StrtoE5M2("61440") == 0x7C); // tie, rounds to even (= inf)
+    CHECK(StrtoE5M2("61440", true) == 0x7B);
+    CHECK(StrtoE5M2("-inf") == 0xFC);
+    CHECK(StrtoE5M2("-inf", true) == 0xFB);
+    CHECK(StrtoE5M2("nan") == 0x7E);
+    CHECK(StrtoE5M2("1.125") == 0x3C); // tie
+    CHECK(StrtoE5M2("1.12500000000000000001") == 0x3D);
+    CHECK(StrtoE5M2("1e-10") == 0x00);
+
+    const std::string str = "1, 448, 1000, x";
+    uint8_t values[4];
+    REQUIRE(fp8::StrtoE4M3Batch(str.data(), str.data() + str.size(), ',', values, 4, true) == 4);
+    CHECK(values[0] == 0x38);
+    CHECK(values[1] == 0x7E);
+    CHECK(values[2] == 0x7E);
+    CHECK(values[3] == 0x7F);
+    REQUIRE(fp8::StrtoE5M2Batch(str.data(), str.data() + str.size(), ',', values, 4) == 4);
+    CHECK(values[0] == 0x3C);
+    CHECK(values[2] == 0x64); // 1024
+    CHECK(values[3] == 0x7E);
+}
+
 #endif // 0
 
 TEST_CASE("Strtod - syntax")